@@ -0,0 +1,372 @@
+#ifndef __ALGORITHM_H__
+#define __ALGORITHM_H__
+
+#include <stddef.h>
+#include <type_traits.h>
+#include <functional.h>
+#include <array.h>
+
+// Orders a and b without branching on the comparison, which compiles to conditional moves for scalars.
+template<typename T, typename Compare> constexpr void sortPair(T &a, T &b, const Compare &comp) noexcept
+{
+	const bool exchange = comp(b, a);
+	const T first = exchange ? b : a;
+	const T second = exchange ? a : b;
+	a = first;
+	b = second;
+}
+
+template<typename T> constexpr void exchangeValues(T &a, T &b) noexcept
+{
+	T tmp = a;
+	a = b;
+	b = tmp;
+}
+
+// Optimal (smallest known) sorting networks for up to 8 elements.
+template<size_t N> struct sortNetwork;
+template<> struct sortNetwork<0>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const, const Compare &) noexcept { }
+};
+template<> struct sortNetwork<1> : sortNetwork<0> { };
+template<> struct sortNetwork<2>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[1], comp);
+	}
+};
+template<> struct sortNetwork<3>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[2], comp);
+		sortPair(v[0], v[1], comp);
+		sortPair(v[1], v[2], comp);
+	}
+};
+template<> struct sortNetwork<4>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[1], comp);
+		sortPair(v[2], v[3], comp);
+		sortPair(v[0], v[2], comp);
+		sortPair(v[1], v[3], comp);
+		sortPair(v[1], v[2], comp);
+	}
+};
+template<> struct sortNetwork<5>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[3], comp);
+		sortPair(v[1], v[4], comp);
+		sortPair(v[0], v[2], comp);
+		sortPair(v[1], v[3], comp);
+		sortPair(v[0], v[1], comp);
+		sortPair(v[2], v[4], comp);
+		sortPair(v[1], v[2], comp);
+		sortPair(v[3], v[4], comp);
+		sortPair(v[2], v[3], comp);
+	}
+};
+template<> struct sortNetwork<6>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[5], comp);
+		sortPair(v[1], v[3], comp);
+		sortPair(v[2], v[4], comp);
+		sortPair(v[1], v[2], comp);
+		sortPair(v[3], v[4], comp);
+		sortPair(v[0], v[3], comp);
+		sortPair(v[2], v[5], comp);
+		sortPair(v[0], v[1], comp);
+		sortPair(v[2], v[3], comp);
+		sortPair(v[4], v[5], comp);
+		sortPair(v[1], v[2], comp);
+		sortPair(v[3], v[4], comp);
+	}
+};
+template<> struct sortNetwork<7>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[6], comp);
+		sortPair(v[2], v[3], comp);
+		sortPair(v[4], v[5], comp);
+		sortPair(v[0], v[2], comp);
+		sortPair(v[1], v[4], comp);
+		sortPair(v[3], v[6], comp);
+		sortPair(v[0], v[1], comp);
+		sortPair(v[2], v[5], comp);
+		sortPair(v[3], v[4], comp);
+		sortPair(v[1], v[2], comp);
+		sortPair(v[4], v[6], comp);
+		sortPair(v[2], v[3], comp);
+		sortPair(v[4], v[5], comp);
+		sortPair(v[1], v[2], comp);
+		sortPair(v[3], v[4], comp);
+		sortPair(v[5], v[6], comp);
+	}
+};
+template<> struct sortNetwork<8>
+{
+	template<typename T, typename Compare> static constexpr void apply(T *const v, const Compare &comp) noexcept
+	{
+		sortPair(v[0], v[2], comp);
+		sortPair(v[1], v[3], comp);
+		sortPair(v[4], v[6], comp);
+		sortPair(v[5], v[7], comp);
+		sortPair(v[0], v[4], comp);
+		sortPair(v[1], v[5], comp);
+		sortPair(v[2], v[6], comp);
+		sortPair(v[3], v[7], comp);
+		sortPair(v[0], v[1], comp);
+		sortPair(v[2], v[3], comp);
+		sortPair(v[4], v[5], comp);
+		sortPair(v[6], v[7], comp);
+		sortPair(v[2], v[4], comp);
+		sortPair(v[3], v[5], comp);
+		sortPair(v[1], v[4], comp);
+		sortPair(v[3], v[6], comp);
+		sortPair(v[1], v[2], comp);
+		sortPair(v[3], v[4], comp);
+		sortPair(v[5], v[6], comp);
+	}
+};
+
+template<typename T, typename Compare> constexpr void insertionSort(T *const first, T *const last, const Compare &comp) noexcept
+{
+	if (first == last)
+		return;
+	for (T *i = first + 1; i != last; ++i)
+	{
+		T value = *i;
+		T *j = i;
+		for (; j != first && comp(value, j[-1]); --j)
+			*j = j[-1];
+		*j = value;
+	}
+}
+
+template<typename T, typename Compare> constexpr void siftDown(T *const first, size_t root, const size_t length,
+	const Compare &comp) noexcept
+{
+	T value = first[root];
+	for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1)
+	{
+		if (child + 1 < length && comp(first[child], first[child + 1]))
+			++child;
+		if (!comp(value, first[child]))
+			break;
+		first[root] = first[child];
+		root = child;
+	}
+	first[root] = value;
+}
+
+template<typename T, typename Compare> constexpr void heapSort(T *const first, T *const last, const Compare &comp) noexcept
+{
+	const size_t length = last - first;
+	for (size_t i = length / 2; i > 0; --i)
+		siftDown(first, i - 1, length, comp);
+	for (size_t i = length; i > 1; --i)
+	{
+		exchangeValues(first[0], first[i - 1]);
+		siftDown(first, 0, i - 1, comp);
+	}
+}
+
+// Partitions around the median of the first, middle and last elements, returning the pivot's final position.
+template<typename T, typename Compare> constexpr T *partitionMedianOf3(T *const first, T *const last,
+	const Compare &comp) noexcept
+{
+	T *const middle = first + (last - first) / 2;
+	sortPair(*first, *middle, comp);
+	sortPair(*middle, last[-1], comp);
+	sortPair(*first, *middle, comp);
+	// first and last - 1 are now sentinels, so the scans below need no bounds checks.
+	exchangeValues(*middle, last[-2]);
+	const T pivot = last[-2];
+	T *i = first;
+	T *j = last - 2;
+	while (true)
+	{
+		while (comp(*++i, pivot))
+			continue;
+		while (comp(pivot, *--j))
+			continue;
+		if (i >= j)
+			break;
+		exchangeValues(*i, *j);
+	}
+	exchangeValues(*i, last[-2]);
+	return i;
+}
+
+static constexpr size_t insertionSortThreshold = 16;
+
+template<typename T, typename Compare> constexpr void introSort(T *first, T *last, size_t depth, const Compare &comp) noexcept
+{
+	while (size_t(last - first) > insertionSortThreshold)
+	{
+		if (!depth--)
+		{
+			heapSort(first, last, comp);
+			return;
+		}
+		T *const pivot = partitionMedianOf3(first, last, comp);
+		// Recurse into the smaller side so stack use is bounded by log2(n).
+		if (pivot - first < last - pivot)
+		{
+			introSort(first, pivot, depth, comp);
+			first = pivot + 1;
+		}
+		else
+		{
+			introSort(pivot + 1, last, depth, comp);
+			last = pivot;
+		}
+	}
+}
+
+constexpr inline size_t floorLog2(size_t value) noexcept
+{
+	size_t result = 0;
+	while (value >>= 1)
+		++result;
+	return result;
+}
+
+// Introsort - quicksort which falls back to heapsort on bad pivots, finished with one insertion sort pass.
+template<typename T, typename Compare> constexpr void sort(T *const first, T *const last, const Compare &comp) noexcept
+{
+	if (size_t(last - first) > insertionSortThreshold)
+		introSort(first, last, 2 * floorLog2(last - first), comp);
+	insertionSort(first, last, comp);
+}
+
+template<typename T> constexpr void sort(T *const first, T *const last) noexcept
+	{ sort(first, last, lessThan<T>()); }
+
+// For a fixed N, pick a sorting network, insertion sort or introsort at compile time.
+template<typename T, size_t N, typename Compare> typename enableIf<(N <= 8)>::type
+	sort(array<T, N> &values, const Compare &comp) noexcept { sortNetwork<N>::apply(values.data(), comp); }
+template<typename T, size_t N, typename Compare> typename enableIf<(N > 8 && N <= 32)>::type
+	sort(array<T, N> &values, const Compare &comp) noexcept { insertionSort(values.begin(), values.begin() + N, comp); }
+template<typename T, size_t N, typename Compare> typename enableIf<(N > 32)>::type
+	sort(array<T, N> &values, const Compare &comp) noexcept { sort(values.begin(), values.begin() + N, comp); }
+template<typename T, size_t N> void sort(array<T, N> &values) noexcept { sort(values, lessThan<T>()); }
+
+template<typename T, typename Compare> void sort(iterate<T> values, const Compare &comp) noexcept
+	{ sort(values.begin(), values.end(), comp); }
+template<typename T> void sort(iterate<T> values) noexcept { sort(values, lessThan<T>()); }
+
+/*
+ * Selection only ever needs the side holding nth, so unlike sort() it pays to keep partitioning
+ * down to a handful of elements rather than insertion sorting a whole 16 element range.
+ */
+static constexpr size_t selectionThreshold = 4;
+
+// Rearranges the range so nth holds the value it would in sorted order, with nothing after it ordering before it.
+template<typename T, typename Compare> constexpr void nthElement(T *first, T *const nth, T *last, const Compare &comp) noexcept
+{
+	size_t depth = 2 * floorLog2(last - first);
+	while (size_t(last - first) > selectionThreshold)
+	{
+		if (!depth--)
+		{
+			heapSort(first, last, comp);
+			return;
+		}
+		T *const pivot = partitionMedianOf3(first, last, comp);
+		if (pivot == nth)
+			return;
+		else if (nth < pivot)
+			last = pivot;
+		else
+			first = pivot + 1;
+	}
+	insertionSort(first, last, comp);
+}
+
+template<typename T> constexpr void nthElement(T *const first, T *const nth, T *const last) noexcept
+	{ nthElement(first, nth, last, lessThan<T>()); }
+template<typename T, size_t N, typename Compare> void nthElement(array<T, N> &values, const size_t nth, const Compare &comp) noexcept
+	{ nthElement(values.begin(), values.begin() + nth, values.begin() + N, comp); }
+template<typename T, size_t N> void nthElement(array<T, N> &values, const size_t nth) noexcept
+	{ nthElement(values, nth, lessThan<T>()); }
+template<typename T, typename Compare> void nthElement(iterate<T> values, const size_t nth, const Compare &comp) noexcept
+	{ nthElement(values.begin(), values.begin() + nth, values.end(), comp); }
+template<typename T> void nthElement(iterate<T> values, const size_t nth) noexcept
+	{ nthElement(values, nth, lessThan<T>()); }
+
+// The (upper) median of a sample window. Reorders values.
+template<typename T, size_t N> typename enableIf<(N <= 8), T>::type median(array<T, N> &values) noexcept
+{
+	static_assert(N > 0, "median: cannot take the median of no values");
+	sort(values);
+	return values.data()[N / 2];
+}
+
+template<typename T, size_t N> typename enableIf<(N > 8), T>::type median(array<T, N> &values) noexcept
+{
+	nthElement(values, N / 2);
+	return values.data()[N / 2];
+}
+
+template<typename T> T median(iterate<T> values) noexcept
+{
+	nthElement(values, values.size() / 2);
+	return values.begin()[values.size() / 2];
+}
+
+/*
+ * Branchless binary searches - the loop trip count only depends on the length,
+ * and the comparison result selects the next base with a conditional move rather than a branch.
+ */
+template<typename T, typename Compare> constexpr const T *lowerBound(const T *base, size_t length, const T &value,
+	const Compare &comp) noexcept
+{
+	if (!length)
+		return base;
+	while (length > 1)
+	{
+		const size_t half = length / 2;
+		base = comp(base[half - 1], value) ? base + half : base;
+		length -= half;
+	}
+	return base + comp(*base, value);
+}
+
+template<typename T, typename Compare> constexpr const T *upperBound(const T *base, size_t length, const T &value,
+	const Compare &comp) noexcept
+{
+	if (!length)
+		return base;
+	while (length > 1)
+	{
+		const size_t half = length / 2;
+		base = comp(value, base[half - 1]) ? base : base + half;
+		length -= half;
+	}
+	return base + !comp(value, *base);
+}
+
+template<typename T> constexpr const T *lowerBound(const T *const first, const T *const last, const T &value) noexcept
+	{ return lowerBound(first, last - first, value, lessThan<T>()); }
+template<typename T> constexpr const T *upperBound(const T *const first, const T *const last, const T &value) noexcept
+	{ return upperBound(first, last - first, value, lessThan<T>()); }
+template<typename T, size_t N> constexpr const T *lowerBound(const array<T, N> &values, const T &value) noexcept
+	{ return lowerBound(values.data(), N, value, lessThan<T>()); }
+template<typename T, size_t N> constexpr const T *upperBound(const array<T, N> &values, const T &value) noexcept
+	{ return upperBound(values.data(), N, value, lessThan<T>()); }
+template<typename T> constexpr const T *lowerBound(const iterate<T> &values, const T &value) noexcept
+	{ return lowerBound(values.begin(), values.size(), value, lessThan<T>()); }
+template<typename T> constexpr const T *upperBound(const iterate<T> &values, const T &value) noexcept
+	{ return upperBound(values.begin(), values.size(), value, lessThan<T>()); }
+
+#endif /*__ALGORITHM_H__*/
@@ -112,7 +112,7 @@ public:
 	constexpr size_t size() const noexcept { return N; }
 	iterator begin() noexcept { return arr; }
 	constexpr constIterator begin() const noexcept { return arr; }
-	iterator end() noexcept { return end() + size(); }
+	iterator end() noexcept { return begin() + size(); }
 	constexpr constIterator end() const noexcept { return begin() + size(); }
 };
 
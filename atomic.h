@@ -0,0 +1,192 @@
+#ifndef __ATOMIC_H__
+#define __ATOMIC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits.h>
+#include <criticalSection.h>
+
+enum class memoryOrder : int
+{
+	relaxed = __ATOMIC_RELAXED,
+	consume = __ATOMIC_CONSUME,
+	acquire = __ATOMIC_ACQUIRE,
+	release = __ATOMIC_RELEASE,
+	acqRel = __ATOMIC_ACQ_REL,
+	seqCst = __ATOMIC_SEQ_CST
+};
+
+// The strongest ordering a failed compare-exchange may have for a given success ordering.
+constexpr inline memoryOrder __failureOrder(const memoryOrder order) noexcept
+{
+	return order == memoryOrder::acqRel ? memoryOrder::acquire :
+		order == memoryOrder::release ? memoryOrder::relaxed : order;
+}
+
+template<typename T, typename backend, bool = __atomic_always_lock_free(sizeof(T), 0)> struct __atomicOps;
+
+// Lock-free implementation on the compiler builtins (LDREX/STREX on ARMv7-M and up).
+template<typename T, typename backend> struct __atomicOps<T, backend, true>
+{
+	static T load(const volatile T *const value, const memoryOrder order) noexcept
+	{
+		T result;
+		__atomic_load(value, &result, int(order));
+		return result;
+	}
+
+	static void store(volatile T *const value, T desired, const memoryOrder order) noexcept
+		{ __atomic_store(value, &desired, int(order)); }
+
+	static T exchange(volatile T *const value, T desired, const memoryOrder order) noexcept
+	{
+		T result;
+		__atomic_exchange(value, &desired, &result, int(order));
+		return result;
+	}
+
+	static bool compareExchange(volatile T *const value, T &expected, T desired, const bool weak,
+		const memoryOrder success, const memoryOrder failure) noexcept
+		{ return __atomic_compare_exchange(value, &expected, &desired, weak, int(success), int(failure)); }
+
+	static T fetchAdd(volatile T *const value, const T arg, const memoryOrder order) noexcept
+		{ return __atomic_fetch_add(value, arg, int(order)); }
+	static T fetchSub(volatile T *const value, const T arg, const memoryOrder order) noexcept
+		{ return __atomic_fetch_sub(value, arg, int(order)); }
+	static T fetchAnd(volatile T *const value, const T arg, const memoryOrder order) noexcept
+		{ return __atomic_fetch_and(value, arg, int(order)); }
+	static T fetchOr(volatile T *const value, const T arg, const memoryOrder order) noexcept
+		{ return __atomic_fetch_or(value, arg, int(order)); }
+	static T fetchXor(volatile T *const value, const T arg, const memoryOrder order) noexcept
+		{ return __atomic_fetch_xor(value, arg, int(order)); }
+};
+
+/*
+ * Fallback for cores without exclusive access instructions (eg, ARMv6-M) and oversized types.
+ * Every operation runs inside a critical section, which is also what orders it.
+ */
+template<typename T, typename backend> struct __atomicOps<T, backend, false>
+{
+	typedef criticalSection<backend> section_t;
+
+	static T load(const volatile T *const value, const memoryOrder) noexcept
+	{
+		section_t section;
+		return const_cast<const T &>(*value);
+	}
+
+	static void store(volatile T *const value, const T desired, const memoryOrder) noexcept
+	{
+		section_t section;
+		const_cast<T &>(*value) = desired;
+	}
+
+	static T exchange(volatile T *const value, const T desired, const memoryOrder) noexcept
+	{
+		section_t section;
+		const T result = const_cast<T &>(*value);
+		const_cast<T &>(*value) = desired;
+		return result;
+	}
+
+	static bool compareExchange(volatile T *const value, T &expected, const T desired, const bool,
+		const memoryOrder, const memoryOrder) noexcept
+	{
+		section_t section;
+		T &current = const_cast<T &>(*value);
+		if (__builtin_memcmp(&current, &expected, sizeof(T)))
+		{
+			expected = current;
+			return false;
+		}
+		current = desired;
+		return true;
+	}
+
+	template<typename Op> static T fetchOp(volatile T *const value, const Op op) noexcept
+	{
+		section_t section;
+		T &current = const_cast<T &>(*value);
+		const T result = current;
+		current = op(result);
+		return result;
+	}
+
+	static T fetchAdd(volatile T *const value, const T arg, const memoryOrder) noexcept
+		{ return fetchOp(value, [arg](const T v) noexcept { return T(v + arg); }); }
+	static T fetchSub(volatile T *const value, const T arg, const memoryOrder) noexcept
+		{ return fetchOp(value, [arg](const T v) noexcept { return T(v - arg); }); }
+	static T fetchAnd(volatile T *const value, const T arg, const memoryOrder) noexcept
+		{ return fetchOp(value, [arg](const T v) noexcept { return T(v & arg); }); }
+	static T fetchOr(volatile T *const value, const T arg, const memoryOrder) noexcept
+		{ return fetchOp(value, [arg](const T v) noexcept { return T(v | arg); }); }
+	static T fetchXor(volatile T *const value, const T arg, const memoryOrder) noexcept
+		{ return fetchOp(value, [arg](const T v) noexcept { return T(v ^ arg); }); }
+};
+
+template<typename T, typename backend = defaultCriticalSectionBackend> struct atomic
+{
+private:
+	typedef __atomicOps<T, backend> ops;
+	// Naturally align power-of-two sized values so the builtins can work on them directly.
+	static constexpr size_t alignment = sizeof(T) <= 16 && !(sizeof(T) & (sizeof(T) - 1)) && sizeof(T) > alignof(T) ?
+		sizeof(T) : alignof(T);
+	alignas(alignment) volatile T value;
+
+	template<typename U> using integral_t = typename enableIf<isIntegral<U>::value && !isBoolean<U>::value, U>::type;
+
+public:
+	constexpr atomic() noexcept : value() { }
+	constexpr atomic(const T desired) noexcept : value(desired) { }
+
+	static constexpr bool isLockFree() noexcept { return __atomic_always_lock_free(sizeof(T), 0); }
+
+	T load(const memoryOrder order = memoryOrder::seqCst) const noexcept { return ops::load(&value, order); }
+	void store(const T desired, const memoryOrder order = memoryOrder::seqCst) noexcept { ops::store(&value, desired, order); }
+	T exchange(const T desired, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return ops::exchange(&value, desired, order); }
+
+	bool compareExchangeWeak(T &expected, const T desired, const memoryOrder success, const memoryOrder failure) noexcept
+		{ return ops::compareExchange(&value, expected, desired, true, success, failure); }
+	bool compareExchangeWeak(T &expected, const T desired, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return compareExchangeWeak(expected, desired, order, __failureOrder(order)); }
+	bool compareExchangeStrong(T &expected, const T desired, const memoryOrder success, const memoryOrder failure) noexcept
+		{ return ops::compareExchange(&value, expected, desired, false, success, failure); }
+	bool compareExchangeStrong(T &expected, const T desired, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return compareExchangeStrong(expected, desired, order, __failureOrder(order)); }
+
+	template<typename U = T> integral_t<U> fetchAdd(const T arg, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return ops::fetchAdd(&value, arg, order); }
+	template<typename U = T> integral_t<U> fetchSub(const T arg, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return ops::fetchSub(&value, arg, order); }
+	template<typename U = T> integral_t<U> fetchAnd(const T arg, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return ops::fetchAnd(&value, arg, order); }
+	template<typename U = T> integral_t<U> fetchOr(const T arg, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return ops::fetchOr(&value, arg, order); }
+	template<typename U = T> integral_t<U> fetchXor(const T arg, const memoryOrder order = memoryOrder::seqCst) noexcept
+		{ return ops::fetchXor(&value, arg, order); }
+
+	operator T() const noexcept { return load(); }
+	T operator =(const T desired) noexcept
+	{
+		store(desired);
+		return desired;
+	}
+
+	template<typename U = T> integral_t<U> operator ++() noexcept { return fetchAdd(1) + 1; }
+	template<typename U = T> integral_t<U> operator ++(int) noexcept { return fetchAdd(1); }
+	template<typename U = T> integral_t<U> operator --() noexcept { return fetchSub(1) - 1; }
+	template<typename U = T> integral_t<U> operator --(int) noexcept { return fetchSub(1); }
+	template<typename U = T> integral_t<U> operator +=(const T arg) noexcept { return fetchAdd(arg) + arg; }
+	template<typename U = T> integral_t<U> operator -=(const T arg) noexcept { return fetchSub(arg) - arg; }
+	template<typename U = T> integral_t<U> operator &=(const T arg) noexcept { return fetchAnd(arg) & arg; }
+	template<typename U = T> integral_t<U> operator |=(const T arg) noexcept { return fetchOr(arg) | arg; }
+	template<typename U = T> integral_t<U> operator ^=(const T arg) noexcept { return fetchXor(arg) ^ arg; }
+
+	atomic(const atomic &) = delete;
+	atomic(atomic &&) = delete;
+	atomic &operator =(const atomic &) = delete;
+	atomic &operator =(atomic &&) = delete;
+};
+
+#endif /*__ATOMIC_H__*/
@@ -0,0 +1,48 @@
+#include <algorithm.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench.h"
+
+// sort() and nthElement() against std::sort() and std::nth_element() on random ints, copying in fresh input each time
+// from 1024 variants - with fewer the branch predictor learns the inputs and small N timings mean little.
+
+void report(const char *const what, const size_t length, const benchResult_t ours, const benchResult_t theirs) noexcept
+{
+	printf("%-11s N = %4zu  embd++ %9.1f ns %9.1f cycles   std %9.1f ns %9.1f cycles\n", what, length,
+		ours.nanoseconds, ours.cycles, theirs.nanoseconds, theirs.cycles);
+}
+
+template<typename F> benchResult_t measure(const std::vector<int> &source, std::vector<int> &values, F &&fn) noexcept
+{
+	const size_t length = values.size();
+	const size_t variants = source.size() / length;
+	return benchRun(4000000 / length + 1000, [&](const size_t i) noexcept
+	{
+		std::copy_n(source.begin() + (i % variants) * length, length, values.begin());
+		fn(values.data(), values.data() + length);
+		benchKeep(values[length / 2]);
+	});
+}
+
+int main()
+{
+	for (const size_t length : {3, 5, 8, 16, 32, 64, 256, 1024})
+	{
+		std::vector<int> source(length * 1024);
+		for (auto &value : source)
+			value = rand();
+		std::vector<int> values(length);
+
+		report("sort", length,
+			measure(source, values, [](int *const first, int *const last) noexcept { sort(first, last); }),
+			measure(source, values, [](int *const first, int *const last) noexcept { std::sort(first, last); }));
+		report("nthElement", length,
+			measure(source, values, [](int *const first, int *const last) noexcept
+				{ nthElement(first, first + (last - first) / 2, last); }),
+			measure(source, values, [](int *const first, int *const last) noexcept
+				{ std::nth_element(first, first + (last - first) / 2, last); }));
+	}
+	return 0;
+}
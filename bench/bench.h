@@ -0,0 +1,51 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/*
+ * Minimal timing helpers for the host-side benchmarks run by `make bench`.
+ * Figures are per call and the best of several runs; cycles are x86 TSC reference cycles (0 elsewhere).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+struct benchResult_t
+{
+	double nanoseconds;
+	double cycles;
+};
+
+inline uint64_t benchCycles() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+// Stops the compiler from optimising away the computation of value.
+template<typename T> inline void benchKeep(const T &value) noexcept { asm volatile ("" : : "r" (&value) : "memory"); }
+
+template<typename F> benchResult_t benchRun(const size_t iterations, F &&fn)
+{
+	benchResult_t best{1e300, 1e300};
+	for (size_t run = 0; run < 5; ++run)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const uint64_t startCycles = benchCycles();
+		for (size_t i = 0; i < iterations; ++i)
+			fn(i);
+		const uint64_t cycles = benchCycles() - startCycles;
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		if (elapsed.count() / iterations < best.nanoseconds)
+			best = {elapsed.count() / iterations, double(cycles) / iterations};
+	}
+	return best;
+}
+
+#endif /*__BENCH_H__*/
@@ -0,0 +1,80 @@
+#include <bitset.h>
+#include <bitset>
+#include <cstdio>
+#include <cstdlib>
+#include "bench.h"
+
+/*
+ * bitset<N> against std::bitset<N>. The allocation case models a 256 slot free map:
+ * find the first free slot, claim it and release a random one so the map stays mostly full.
+ */
+
+template<size_t N> size_t findFirstFree(const bitset<N> &set) noexcept { return set.findFirstClear(); }
+template<size_t N> size_t findFirstFree(const std::bitset<N> &set) noexcept
+{
+#ifdef __GLIBCXX__
+	// The fastest scan libstdc++ offers, via its _Find_first() extension.
+	return (~set)._Find_first();
+#else
+	for (size_t i = 0; i < N; ++i)
+	{
+		if (!set[i])
+			return i;
+	}
+	return N;
+#endif
+}
+
+template<typename Set> benchResult_t allocate(const size_t *const releases) noexcept
+{
+	Set set;
+	set.set();
+	for (size_t i = 0; i < 8; ++i)
+		set.reset(releases[i]);
+	return benchRun(1000000, [&](const size_t i) noexcept
+	{
+		const size_t slot = findFirstFree(set);
+		set.set(slot);
+		set.reset(releases[i & 1023]);
+		benchKeep(slot);
+	});
+}
+
+template<typename Set> benchResult_t count(const Set &set) noexcept
+	{ return benchRun(1000000, [&](const size_t) noexcept { benchKeep(set); benchKeep(set.count()); }); }
+
+template<typename Set> benchResult_t combine(Set &a, const Set &b) noexcept
+{
+	return benchRun(1000000, [&](const size_t) noexcept
+	{
+		a ^= b;
+		benchKeep(a);
+	});
+}
+
+void report(const char *const what, const benchResult_t ours, const benchResult_t theirs) noexcept
+{
+	printf("%-28s bitset %6.2f ns %6.1f cycles   std::bitset %6.2f ns %6.1f cycles\n", what,
+		ours.nanoseconds, ours.cycles, theirs.nanoseconds, theirs.cycles);
+}
+
+int main()
+{
+	size_t releases[1024];
+	for (auto &slot : releases)
+		slot = size_t(rand()) % 256;
+	report("256 slot find-first-free", allocate<bitset<256>>(releases), allocate<std::bitset<256>>(releases));
+
+	bitset<256> set;
+	std::bitset<256> reference;
+	for (size_t i = 0; i < 256; i += 3)
+	{
+		set.set(i);
+		reference.set(i);
+	}
+	report("256 bit count()", count(set), count(reference));
+	bitset<256> other(0x12345678);
+	std::bitset<256> otherReference(0x12345678);
+	report("256 bit operator ^=", combine(set, other), combine(reference, otherReference));
+	return 0;
+}
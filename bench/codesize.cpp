@@ -0,0 +1,58 @@
+#include <stdout.h>
+#include <functional.h>
+
+/*
+ * Representative uses of the formatting and calling machinery, compiled (never linked) by codesize.sh
+ * so the .text each instantiation costs can be read off the object file.
+ */
+
+struct nullOutDev : public outDev
+{
+private:
+	volatile char last;
+
+	void initFn(const uint32_t) noexcept { }
+	void writeFn(const char c) noexcept { last = c; }
+
+	static const functions fns;
+
+public:
+	nullOutDev() noexcept : outDev(&fns, this), last(0) { }
+};
+
+const outDev::functions nullOutDev::fns{init_t::make<nullOutDev, &nullOutDev::initFn>(),
+	write_t::make<nullOutDev, &nullOutDev::writeFn>()};
+
+nullOutDev device;
+stdout_t stdout(device);
+
+struct counter_t
+{
+	int count;
+	int bump(const int by) noexcept { return count += by; }
+};
+counter_t counter;
+
+void useInts(const int8_t a, const uint8_t b, const int16_t c, const uint16_t d, const int32_t e, const uint32_t f,
+	const long g, const unsigned long h) noexcept
+{
+	stdout.write("a=", a, " b=", b, " c=", c, " d=", d, '\n');
+	stdout.write("e=", e, " f=", f, " g=", g, " h=", h, '\n');
+}
+
+void useHex(const uint8_t a, const uint16_t b, const uint32_t c, const int8_t d, void *const ptr) noexcept
+{
+	stdout.write(asHex<2, '0'>(a), ' ', asHex<4, '0'>(b), ' ', asHex<8, '0'>(c), ' ', asHex<>(c), ' ',
+		asHex<4>(a), ' ', asHex<2, '0'>(d), ' ', ptr, '\n');
+}
+
+void useArrays(array<uint8_t, 8> &bytes, array<uint16_t, 4> &words, array<int8_t, 4> &signedBytes) noexcept
+	{ stdout.write(bytes, ' ', words, ' ', signedBytes, '\n'); }
+
+int useFunction(function<int(int)> &fn, const int value) noexcept { return fn(value); }
+
+int useCall(const int value) noexcept
+{
+	const auto bump = call<int(int)>::make<counter_t, &counter_t::bump>();
+	return bump(&counter, value);
+}
@@ -0,0 +1,18 @@
+#!/bin/sh
+# Reports the .text cost of bench/codesize.cpp, in total and per instantiation, at each optimisation level.
+# Extra arguments are passed to the compiler, eg: bench/codesize.sh -mcpu=cortex-m4 -mthumb
+# CXX, SIZE, NM and OPTS (default "-Os -O2") may be overridden from the environment.
+set -e
+
+CXX=${CXX:-g++}
+SIZE=${SIZE:-size}
+NM=${NM:-nm}
+root=$(dirname "$0")/..
+object=$(mktemp)
+trap 'rm -f "$object"' EXIT
+
+for opt in ${OPTS:--Os -O2}; do
+	$CXX -std=c++14 $opt -fno-asynchronous-unwind-tables "$@" -I"$root" -c "$root/bench/codesize.cpp" -o "$object"
+	echo "$opt: $($SIZE -A "$object" | awk '$1 ~ /^\.text/ { total += $2 } END { print total }') bytes of .text"
+	$NM -C -S -t d --size-sort "$object" | awk '$3 ~ /^[tTwW]$/ { size = $2 + 0; $1 = $2 = $3 = ""; sub(/^ +/, ""); printf "  %6d %s\n", size, $0 }'
+done
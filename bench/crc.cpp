@@ -0,0 +1,38 @@
+#include <crc.h>
+#include <cstdio>
+#include "bench.h"
+
+// Throughput of each crc<> method over a 4KiB buffer, as bytes per nanosecond and per TSC cycle.
+
+static uint8_t data[4096];
+
+template<typename crc_t> void report(const char *const name, const char *const method) noexcept
+{
+	const benchResult_t result = benchRun(2000, [](const size_t) noexcept
+	{
+		benchKeep(data);
+		benchKeep(crc_t::compute(data, sizeof(data)));
+	});
+	printf("%-8s %-12s %7.3f bytes/ns", name, method, sizeof(data) / result.nanoseconds);
+	if (result.cycles)
+		printf(" %7.3f bytes/cycle", sizeof(data) / result.cycles);
+	printf("\n");
+}
+
+template<template<crcMethod> class crc_t> void reportAll(const char *const name) noexcept
+{
+	report<crc_t<crcMethod::bitwise>>(name, "bitwise");
+	report<crc_t<crcMethod::nibbleTable>>(name, "nibbleTable");
+	report<crc_t<crcMethod::byteTable>>(name, "byteTable");
+	report<crc_t<crcMethod::sliceBy8>>(name, "sliceBy8");
+}
+
+int main()
+{
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = uint8_t(i * 131 + 7);
+	reportAll<crc8_t>("CRC-8");
+	reportAll<crc16Ccitt_t>("CRC-16");
+	reportAll<crc32_t>("CRC-32");
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "bench.h"
+
+// The formatters against snprintf() over the same random values.
+
+size_t formatFloat(char *buffer, size_t length, float value) noexcept;
+size_t formatFloatPrecision(char *buffer, size_t length, float value) noexcept;
+size_t formatMessage(char *buffer, size_t length, uint32_t id, const char *name, size_t nameLength, uint16_t flags) noexcept;
+
+constexpr size_t valueCount = 1024;
+static float floats[valueCount];
+
+void report(const char *const what, const benchResult_t ours, const benchResult_t theirs) noexcept
+{
+	printf("%-32s embd++ %7.1f ns %7.1f cycles   snprintf %7.1f ns %7.1f cycles\n", what,
+		ours.nanoseconds, ours.cycles, theirs.nanoseconds, theirs.cycles);
+}
+
+int main()
+{
+	for (auto &value : floats)
+	{
+		// Random bit patterns, so every exponent is equally likely, skipping inf and NaN.
+		uint32_t bits;
+		do
+			bits = (uint32_t(rand()) << 16) ^ uint32_t(rand());
+		while (((bits >> 23) & 0xFF) == 0xFF);
+		memcpy(&value, &bits, sizeof(value));
+	}
+
+	char buffer[32];
+	report("asFloat<> vs %.9g", benchRun(200000, [&](const size_t i) noexcept
+		{ benchKeep(formatFloat(buffer, sizeof(buffer), floats[i % valueCount])); }),
+		benchRun(200000, [&](const size_t i) noexcept
+		{ benchKeep(snprintf(buffer, sizeof(buffer), "%.9g", double(floats[i % valueCount]))); }));
+	report("asFloat<4> vs %.4g", benchRun(200000, [&](const size_t i) noexcept
+		{ benchKeep(formatFloatPrecision(buffer, sizeof(buffer), floats[i % valueCount])); }),
+		benchRun(200000, [&](const size_t i) noexcept
+		{ benchKeep(snprintf(buffer, sizeof(buffer), "%.4g", double(floats[i % valueCount]))); }));
+
+	static const char *const names[] = {"uart0", "spi1", "timer2", "dma"};
+	report("bufferOutDev message vs snprintf", benchRun(200000, [&](const size_t i) noexcept
+		{
+			const char *const name = names[i & 3];
+			benchKeep(formatMessage(buffer, sizeof(buffer), uint32_t(i), name, strlen(name), uint16_t(i * 7)));
+		}),
+		benchRun(200000, [&](const size_t i) noexcept
+		{
+			const char *const name = names[i & 3];
+			benchKeep(snprintf(buffer, sizeof(buffer), "id=%u name=%.*s flags=%04X", unsigned(i), int(strlen(name)),
+				name, unsigned(uint16_t(i * 7))));
+		}));
+	return 0;
+}
@@ -0,0 +1,28 @@
+#include <stdout.h>
+
+// The library's side of bench/formatting, kept in its own translation unit as stdout.h and <cstdio> both declare stdout.
+
+size_t formatFloat(char *const buffer, const size_t length, const float value) noexcept
+{
+	bufferOutDev device(buffer, length);
+	stdout_t output(device);
+	output.write(asFloat<>(value));
+	return device.length();
+}
+
+size_t formatFloatPrecision(char *const buffer, const size_t length, const float value) noexcept
+{
+	bufferOutDev device(buffer, length);
+	stdout_t output(device);
+	output.write(asFloat<4>(value));
+	return device.length();
+}
+
+size_t formatMessage(char *const buffer, const size_t length, const uint32_t id, const char *const name,
+	const size_t nameLength, const uint16_t flags) noexcept
+{
+	bufferOutDev device(buffer, length);
+	stdout_t output(device);
+	output.write("id="_sv, id, " name="_sv, stringView(name, nameLength), " flags="_sv, asHex<4, '0'>(flags));
+	return device.length();
+}
@@ -0,0 +1,123 @@
+#include <intrusiveList.h>
+#include <intrusiveHeap.h>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <queue>
+#include <set>
+#include <vector>
+#include "bench.h"
+
+/*
+ * A timer-wheel style workload over 1024 pending timers: expire the earliest and re-arm it, cancel and re-arm
+ * an arbitrary one, and rotate a run queue - against std::priority_queue, std::multiset and std::list.
+ */
+
+struct heapTag_t;
+struct benchTimer : public listNode<>, public heapNode<heapTag_t>
+{
+	uint32_t deadline;
+	bool operator <(const benchTimer &other) const noexcept { return deadline < other.deadline; }
+};
+
+struct laterFirst
+{
+	bool operator ()(const benchTimer *const a, const benchTimer *const b) const noexcept { return b->deadline < a->deadline; }
+};
+
+constexpr size_t timerCount = 1024;
+constexpr size_t iterations = 1000000;
+benchTimer timers[timerCount];
+uint32_t delays[4096];
+
+void report(const char *const what, const char *const theirName, const benchResult_t ours, const benchResult_t theirs) noexcept
+{
+	printf("%-24s intrusive %6.1f ns %6.1f cycles   %-20s %6.1f ns %6.1f cycles\n", what,
+		ours.nanoseconds, ours.cycles, theirName, theirs.nanoseconds, theirs.cycles);
+}
+
+void resetDeadlines() noexcept
+{
+	for (size_t i = 0; i < timerCount; ++i)
+		timers[i].deadline = delays[i];
+}
+
+int main()
+{
+	for (auto &delay : delays)
+		delay = 1 + uint32_t(rand()) % 10000;
+
+	resetDeadlines();
+	intrusiveHeap<benchTimer, lessThan<benchTimer>, heapTag_t> heap;
+	for (auto &timer : timers)
+		heap.push(timer);
+	const benchResult_t heapExpire = benchRun(iterations, [&](const size_t i) noexcept
+	{
+		benchTimer &timer = heap.pop();
+		timer.deadline += delays[i & 4095];
+		heap.push(timer);
+	});
+	heap.clear();
+
+	resetDeadlines();
+	std::priority_queue<benchTimer *, std::vector<benchTimer *>, laterFirst> queue;
+	for (auto &timer : timers)
+		queue.push(&timer);
+	const benchResult_t queueExpire = benchRun(iterations, [&](const size_t i) noexcept
+	{
+		benchTimer *const timer = queue.top();
+		queue.pop();
+		timer->deadline += delays[i & 4095];
+		queue.push(timer);
+	});
+	report("expire and re-arm", "std::priority_queue", heapExpire, queueExpire);
+
+	// std::priority_queue cannot remove arbitrary elements, so cancellation is against std::multiset.
+	resetDeadlines();
+	for (auto &timer : timers)
+		heap.push(timer);
+	const benchResult_t heapCancel = benchRun(iterations, [&](const size_t i) noexcept
+	{
+		benchTimer &timer = timers[(i * 7919) % timerCount];
+		heap.remove(timer);
+		timer.deadline += delays[i & 4095];
+		heap.push(timer);
+	});
+	heap.clear();
+
+	resetDeadlines();
+	std::multiset<std::pair<uint32_t, benchTimer *>> set;
+	for (auto &timer : timers)
+		set.emplace(timer.deadline, &timer);
+	const benchResult_t setCancel = benchRun(iterations, [&](const size_t i) noexcept
+	{
+		benchTimer &timer = timers[(i * 7919) % timerCount];
+		set.erase(set.find(std::make_pair(timer.deadline, &timer)));
+		timer.deadline += delays[i & 4095];
+		set.emplace(timer.deadline, &timer);
+	});
+	report("cancel and re-arm", "std::multiset", heapCancel, setCancel);
+
+	intrusiveList<benchTimer> runQueue;
+	std::list<benchTimer *> stdRunQueue;
+	for (auto &timer : timers)
+	{
+		runQueue.pushBack(timer);
+		stdRunQueue.push_back(&timer);
+	}
+	const benchResult_t listRotate = benchRun(iterations, [&](const size_t) noexcept
+	{
+		benchTimer &timer = runQueue.popFront();
+		runQueue.pushBack(timer);
+		benchKeep(timer);
+	});
+	const benchResult_t stdListRotate = benchRun(iterations, [&](const size_t) noexcept
+	{
+		benchTimer *const timer = stdRunQueue.front();
+		stdRunQueue.pop_front();
+		stdRunQueue.push_back(timer);
+		benchKeep(timer);
+	});
+	report("run queue rotate", "std::list", listRotate, stdListRotate);
+	return 0;
+}
@@ -0,0 +1,192 @@
+#ifndef __BITSET_H__
+#define __BITSET_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array.h>
+
+constexpr inline uint8_t countTrailingZeros(const unsigned int value) noexcept { return __builtin_ctz(value); }
+constexpr inline uint8_t countTrailingZeros(const unsigned long value) noexcept { return __builtin_ctzl(value); }
+constexpr inline uint8_t countTrailingZeros(const unsigned long long value) noexcept { return __builtin_ctzll(value); }
+constexpr inline uint8_t popCount(const unsigned int value) noexcept { return __builtin_popcount(value); }
+constexpr inline uint8_t popCount(const unsigned long value) noexcept { return __builtin_popcountl(value); }
+constexpr inline uint8_t popCount(const unsigned long long value) noexcept { return __builtin_popcountll(value); }
+
+template<size_t N> struct bitset
+{
+private:
+	static_assert(N > 0, "bitset: N cannot be 0");
+	typedef uintptr_t word_t;
+	static constexpr size_t wordBits = sizeof(word_t) * 8;
+	static constexpr size_t words = (N + wordBits - 1) / wordBits;
+	// Mask of the bits in the last word that are part of the set - bits outside of this are always kept 0.
+	static constexpr word_t tailMask = N % wordBits ? (word_t(1) << (N % wordBits)) - 1 : ~word_t(0);
+	array<word_t, words> bits;
+
+	static constexpr size_t wordFor(const size_t pos) noexcept { return pos / wordBits; }
+	static constexpr word_t maskFor(const size_t pos) noexcept { return word_t(1) << (pos % wordBits); }
+
+	// Scans forward from word index `word` for the first set bit in `first` or the words that follow it.
+	template<bool invert> size_t scan(size_t word, word_t first) const noexcept
+	{
+		const word_t *const data = bits.data();
+		while (!first)
+		{
+			if (++word == words)
+				return N;
+			first = invert ? ~data[word] : data[word];
+		}
+		const size_t pos = (word * wordBits) + countTrailingZeros(first);
+		// When inverted, the unused tail bits read as clear, so clamp those back to N.
+		return pos < N ? pos : N;
+	}
+
+public:
+	constexpr bitset() noexcept : bits(word_t(0)) { }
+	constexpr bitset(const word_t value) noexcept : bits(word_t(value & (words == 1 ? tailMask : ~word_t(0)))) { }
+
+	constexpr size_t size() const noexcept { return N; }
+
+	constexpr bool test(const size_t pos) const noexcept
+		{ return pos < N && (bits.data()[wordFor(pos)] & maskFor(pos)); }
+	constexpr bool operator [](const size_t pos) const noexcept { return test(pos); }
+
+	bitset &set(const size_t pos) noexcept
+	{
+		if (pos < N)
+			bits.data()[wordFor(pos)] |= maskFor(pos);
+		return *this;
+	}
+
+	bitset &set(const size_t pos, const bool value) noexcept
+		{ return value ? set(pos) : reset(pos); }
+
+	bitset &set() noexcept
+	{
+		word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+			data[i] = ~word_t(0);
+		data[words - 1] &= tailMask;
+		return *this;
+	}
+
+	bitset &reset(const size_t pos) noexcept
+	{
+		if (pos < N)
+			bits.data()[wordFor(pos)] &= ~maskFor(pos);
+		return *this;
+	}
+
+	bitset &reset() noexcept
+	{
+		bits.clear();
+		return *this;
+	}
+
+	bitset &flip(const size_t pos) noexcept
+	{
+		if (pos < N)
+			bits.data()[wordFor(pos)] ^= maskFor(pos);
+		return *this;
+	}
+
+	bitset &flip() noexcept
+	{
+		word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+			data[i] = ~data[i];
+		data[words - 1] &= tailMask;
+		return *this;
+	}
+
+	size_t count() const noexcept
+	{
+		const word_t *const data = bits.data();
+		size_t result = 0;
+		for (size_t i = 0; i < words; ++i)
+			result += popCount(data[i]);
+		return result;
+	}
+
+	bool any() const noexcept
+	{
+		const word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+		{
+			if (data[i])
+				return true;
+		}
+		return false;
+	}
+
+	bool none() const noexcept { return !any(); }
+	bool all() const noexcept { return findFirstClear() == N; }
+
+	// These return size() if there is no such bit.
+	size_t findFirstSet() const noexcept { return scan<false>(0, bits.data()[0]); }
+	size_t findFirstClear() const noexcept { return scan<true>(0, ~bits.data()[0]); }
+
+	// Finds the first set bit strictly after pos.
+	size_t findNextSet(const size_t pos) const noexcept
+	{
+		const size_t next = pos + 1;
+		if (next >= N)
+			return N;
+		const size_t word = wordFor(next);
+		return scan<false>(word, bits.data()[word] & (~word_t(0) << (next % wordBits)));
+	}
+
+	// Finds the first clear bit strictly after pos.
+	size_t findNextClear(const size_t pos) const noexcept
+	{
+		const size_t next = pos + 1;
+		if (next >= N)
+			return N;
+		const size_t word = wordFor(next);
+		return scan<true>(word, ~bits.data()[word] & (~word_t(0) << (next % wordBits)));
+	}
+
+	bitset &operator &=(const bitset &other) noexcept
+	{
+		word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+			data[i] &= other.bits.data()[i];
+		return *this;
+	}
+
+	bitset &operator |=(const bitset &other) noexcept
+	{
+		word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+			data[i] |= other.bits.data()[i];
+		return *this;
+	}
+
+	bitset &operator ^=(const bitset &other) noexcept
+	{
+		word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+			data[i] ^= other.bits.data()[i];
+		return *this;
+	}
+
+	bitset operator ~() const noexcept { return bitset(*this).flip(); }
+	bitset operator &(const bitset &other) const noexcept { return bitset(*this) &= other; }
+	bitset operator |(const bitset &other) const noexcept { return bitset(*this) |= other; }
+	bitset operator ^(const bitset &other) const noexcept { return bitset(*this) ^= other; }
+
+	bool operator ==(const bitset &other) const noexcept
+	{
+		const word_t *const data = bits.data();
+		for (size_t i = 0; i < words; ++i)
+		{
+			if (data[i] != other.bits.data()[i])
+				return false;
+		}
+		return true;
+	}
+
+	bool operator !=(const bitset &other) const noexcept { return !(*this == other); }
+};
+
+#endif /*__BITSET_H__*/
@@ -0,0 +1,260 @@
+#ifndef __CRC_H__
+#define __CRC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits.h>
+#include <array.h>
+
+/*
+ * How a crc<> instance consumes data - this trades flash for speed:
+ * bitwise uses no tables, nibbleTable 16 entries, byteTable 256 entries and sliceBy8 8 * 256 entries.
+ * All tables are generated at compile time.
+ */
+enum class crcMethod : uint8_t
+{
+	bitwise,
+	nibbleTable,
+	byteTable,
+	sliceBy8
+};
+
+template<uint8_t width> struct __crcType
+{
+	static_assert(width > 0 && width <= 64, "crc: width must be between 1 and 64 bits");
+	typedef typename conditional<width <= 8, uint8_t,
+		typename conditional<width <= 16, uint16_t,
+		typename conditional<width <= 32, uint32_t, uint64_t>::type>::type>::type type;
+};
+
+constexpr inline uint64_t __crcReflect(const uint64_t value, const uint8_t bits) noexcept
+{
+	uint64_t result = 0;
+	for (uint8_t i = 0; i < bits; ++i)
+	{
+		if (value & (uint64_t(1) << i))
+			result |= uint64_t(1) << (bits - 1 - i);
+	}
+	return result;
+}
+
+template<typename T, bool reflected> struct __crcStep
+{
+	static constexpr uint8_t typeBits = sizeof(T) * 8;
+	static constexpr T topBit = T(T(1) << (typeBits - 1));
+
+	// Runs `bits` bits of the register through the polynomial, with no new data.
+	static constexpr T shift(T reg, const T poly, const uint8_t bits) noexcept
+	{
+		for (uint8_t i = 0; i < bits; ++i)
+		{
+			if (reflected)
+				reg = (reg & 1) ? T(T(reg >> 1) ^ poly) : T(reg >> 1);
+			else
+				reg = (reg & topBit) ? T(T(reg << 1) ^ poly) : T(reg << 1);
+		}
+		return reg;
+	}
+
+	// Shifts a whole byte out of the register, leaving it to be filled from a table.
+	static constexpr T shiftByte(const T reg) noexcept
+		{ return typeBits == 8 ? T(0) : reflected ? T(reg >> 8) : T(uint64_t(reg) << 8); }
+	static constexpr uint8_t byteIndex(const T reg) noexcept
+		{ return reflected ? uint8_t(reg) : uint8_t(reg >> (typeBits - 8)); }
+};
+
+template<typename T, T poly, bool reflected, size_t slices> struct __crcTable
+{
+private:
+	typedef __crcStep<T, reflected> step;
+
+public:
+	T table[slices][256];
+
+	constexpr __crcTable() noexcept : table{}
+	{
+		for (size_t i = 0; i < 256; ++i)
+			table[0][i] = step::shift(reflected ? T(i) : T(uint64_t(i) << (step::typeBits - 8)), poly, 8);
+		// Slice n holds the effect of a byte followed by n zero bytes.
+		for (size_t n = 1; n < slices; ++n)
+		{
+			for (size_t i = 0; i < 256; ++i)
+			{
+				const T prev = table[n - 1][i];
+				table[n][i] = step::shiftByte(prev) ^ table[0][step::byteIndex(prev)];
+			}
+		}
+	}
+};
+
+template<typename T, T poly, bool reflected> struct __crcNibbleTable
+{
+private:
+	typedef __crcStep<T, reflected> step;
+
+public:
+	T table[16];
+
+	constexpr __crcNibbleTable() noexcept : table{}
+	{
+		for (size_t i = 0; i < 16; ++i)
+			table[i] = step::shift(reflected ? T(i) : T(uint64_t(i) << (step::typeBits - 4)), poly, 4);
+	}
+};
+
+template<typename T, T poly, bool reflected, crcMethod method> struct __crcEngine;
+
+template<typename T, T poly, bool reflected> struct __crcEngine<T, poly, reflected, crcMethod::bitwise>
+{
+	typedef __crcStep<T, reflected> step;
+
+	static T update(T reg, const uint8_t *data, size_t length) noexcept
+	{
+		for (; length; --length)
+		{
+			if (reflected)
+				reg ^= *data++;
+			else
+				reg ^= T(uint64_t(*data++) << (step::typeBits - 8));
+			reg = step::shift(reg, poly, 8);
+		}
+		return reg;
+	}
+};
+
+template<typename T, T poly, bool reflected> struct __crcEngine<T, poly, reflected, crcMethod::nibbleTable>
+{
+	typedef __crcStep<T, reflected> step;
+	static constexpr __crcNibbleTable<T, poly, reflected> nibbles{};
+
+	static T nibble(const T reg) noexcept
+	{
+		if (reflected)
+			return T(reg >> 4) ^ nibbles.table[reg & 0x0F];
+		return T(uint64_t(reg) << 4) ^ nibbles.table[reg >> (step::typeBits - 4)];
+	}
+
+	static T update(T reg, const uint8_t *data, size_t length) noexcept
+	{
+		for (; length; --length)
+		{
+			if (reflected)
+				reg ^= *data++;
+			else
+				reg ^= T(uint64_t(*data++) << (step::typeBits - 8));
+			reg = nibble(nibble(reg));
+		}
+		return reg;
+	}
+};
+template<typename T, T poly, bool reflected> constexpr __crcNibbleTable<T, poly, reflected>
+	__crcEngine<T, poly, reflected, crcMethod::nibbleTable>::nibbles;
+
+template<typename T, T poly, bool reflected> struct __crcEngine<T, poly, reflected, crcMethod::byteTable>
+{
+	typedef __crcStep<T, reflected> step;
+	static constexpr __crcTable<T, poly, reflected, 1> bytes{};
+
+	static T update(T reg, const uint8_t *data, size_t length) noexcept
+	{
+		for (; length; --length)
+			reg = step::shiftByte(reg) ^ bytes.table[0][step::byteIndex(reg) ^ *data++];
+		return reg;
+	}
+};
+template<typename T, T poly, bool reflected> constexpr __crcTable<T, poly, reflected, 1>
+	__crcEngine<T, poly, reflected, crcMethod::byteTable>::bytes;
+
+template<typename T, T poly, bool reflected> struct __crcEngine<T, poly, reflected, crcMethod::sliceBy8>
+{
+	typedef __crcStep<T, reflected> step;
+	static constexpr uint8_t typeBytes = sizeof(T);
+	static constexpr __crcTable<T, poly, reflected, 8> slices{};
+
+	// Byte n of the register as it lines up against the incoming data stream.
+	static uint8_t regByte(const T reg, const uint8_t n) noexcept
+	{
+		if (n >= typeBytes)
+			return 0;
+		return reflected ? uint8_t(reg >> (8 * n)) : uint8_t(reg >> (8 * (typeBytes - 1 - n)));
+	}
+
+	static T update(T reg, const uint8_t *data, size_t length) noexcept
+	{
+		// The register is never wider than 8 bytes, so each block fully absorbs it.
+		for (; length >= 8; length -= 8, data += 8)
+		{
+			T result = 0;
+			for (uint8_t n = 0; n < 8; ++n)
+				result ^= slices.table[7 - n][data[n] ^ regByte(reg, n)];
+			reg = result;
+		}
+		for (; length; --length)
+			reg = step::shiftByte(reg) ^ slices.table[0][step::byteIndex(reg) ^ *data++];
+		return reg;
+	}
+};
+template<typename T, T poly, bool reflected> constexpr __crcTable<T, poly, reflected, 8>
+	__crcEngine<T, poly, reflected, crcMethod::sliceBy8>::slices;
+
+/*
+ * CRC described by the usual Rocksoft parameters (width, poly, refin = refout, init, xorout).
+ * Non-reflected CRCs narrower than their storage type are kept left-aligned internally
+ * so every method can work a byte at a time.
+ */
+template<uint8_t width, uint64_t polynomial, bool reflected, uint64_t initial, uint64_t xorOut,
+	crcMethod method = crcMethod::byteTable> struct crc
+{
+public:
+	typedef typename __crcType<width>::type crc_t;
+
+private:
+	static constexpr uint8_t typeBits = sizeof(crc_t) * 8;
+	static constexpr uint8_t regShift = reflected ? 0 : typeBits - width;
+	static constexpr uint64_t widthMask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+	static constexpr crc_t regPoly = reflected ? crc_t(__crcReflect(polynomial & widthMask, width)) :
+		crc_t((polynomial & widthMask) << regShift);
+	static constexpr crc_t regInit = reflected ? crc_t(__crcReflect(initial & widthMask, width)) :
+		crc_t((initial & widthMask) << regShift);
+	typedef __crcEngine<crc_t, regPoly, reflected, method> engine;
+
+	crc_t reg;
+
+public:
+	constexpr crc() noexcept : reg(regInit) { }
+
+	void reset() noexcept { reg = regInit; }
+	constexpr crc_t value() const noexcept { return crc_t((reg >> regShift) ^ (xorOut & widthMask)); }
+
+	crc &update(const uint8_t byte) noexcept
+	{
+		reg = engine::update(reg, &byte, 1);
+		return *this;
+	}
+
+	crc &update(const void *const data, const size_t length) noexcept
+	{
+		reg = engine::update(reg, static_cast<const uint8_t *>(data), length);
+		return *this;
+	}
+
+	template<typename T> crc &update(const iterate<T> &data) noexcept
+		{ return update(data.begin(), data.size() * sizeof(T)); }
+	template<typename T, size_t N> crc &update(const array<T, N> &data) noexcept
+		{ return update(data.data(), N * sizeof(T)); }
+
+	static crc_t compute(const void *const data, const size_t length) noexcept
+		{ return crc().update(data, length).value(); }
+	template<typename T> static crc_t compute(const iterate<T> &data) noexcept
+		{ return crc().update(data).value(); }
+	template<typename T, size_t N> static crc_t compute(const array<T, N> &data) noexcept
+		{ return crc().update(data).value(); }
+};
+
+template<crcMethod method = crcMethod::byteTable> using crc8_t = crc<8, 0x07, false, 0x00, 0x00, method>;
+template<crcMethod method = crcMethod::byteTable> using crc16Ccitt_t = crc<16, 0x1021, false, 0xFFFF, 0x0000, method>;
+template<crcMethod method = crcMethod::byteTable> using crc16Modbus_t = crc<16, 0x8005, true, 0xFFFF, 0x0000, method>;
+template<crcMethod method = crcMethod::byteTable> using crc32_t = crc<32, 0x04C11DB7, true, 0xFFFFFFFF, 0xFFFFFFFF, method>;
+template<crcMethod method = crcMethod::byteTable> using crc32c_t = crc<32, 0x1EDC6F41, true, 0xFFFFFFFF, 0xFFFFFFFF, method>;
+
+#endif /*__CRC_H__*/
@@ -0,0 +1,129 @@
+#ifndef __CRITICAL_SECTION_H__
+#define __CRITICAL_SECTION_H__
+
+#include <stdint.h>
+#include <type_traits.h>
+
+/*
+ * Critical section backends. Each provides a state_t and static enter()/exit() pair,
+ * where exit() is handed back whatever enter() returned so that sections nest correctly.
+ */
+
+// For code that is known to only ever run in one context.
+struct nullBackend
+{
+	typedef uint8_t state_t;
+	static state_t enter() noexcept
+	{
+		asm volatile ("" : : : "memory");
+		return 0;
+	}
+	static void exit(const state_t) noexcept { asm volatile ("" : : : "memory"); }
+};
+
+// Stands in as the default on targets where no backend is known to be safe - see criticalSection.
+struct noDefaultCriticalSectionBackend
+{
+	typedef uint8_t state_t;
+	static state_t enter() noexcept;
+	static void exit(const state_t) noexcept;
+};
+
+#if defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+// Masks all configurable-priority interrupts.
+struct primaskBackend
+{
+	typedef uint32_t state_t;
+	static state_t enter() noexcept
+	{
+		uint32_t primask;
+		asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) : : "memory");
+		return primask;
+	}
+	static void exit(const state_t primask) noexcept { asm volatile ("msr primask, %0" : : "r" (primask) : "memory"); }
+};
+
+#if __ARM_ARCH_ISA_THUMB == 2
+/*
+ * Only masks interrupts at or below the given priority, leaving more urgent ones running.
+ * level is the raw BASEPRI value, so it must already be shifted up by the number of unimplemented priority bits.
+ */
+template<uint8_t level> struct basepriBackend
+{
+	static_assert(level != 0, "basepriBackend: a level of 0 masks no interrupts");
+	typedef uint32_t state_t;
+	static state_t enter() noexcept
+	{
+		uint32_t basepri;
+		// basepri_max only ever raises the masking level, so nesting inside a stricter section is harmless.
+		asm volatile ("mrs %0, basepri\n\tmsr basepri_max, %1" : "=&r" (basepri) : "r" (uint32_t(level)) : "memory");
+		return basepri;
+	}
+	static void exit(const state_t basepri) noexcept { asm volatile ("msr basepri, %0" : : "r" (basepri) : "memory"); }
+};
+#endif
+
+typedef primaskBackend defaultCriticalSectionBackend;
+#elif defined(__linux__) || defined(__unix__)
+// For hosted builds - a recursive process-wide spinlock so sections behave the same across threads.
+struct spinlockBackend
+{
+private:
+	static bool &lock() noexcept
+	{
+		static bool locked = false;
+		return locked;
+	}
+
+	static uint32_t &depth() noexcept
+	{
+		static thread_local uint32_t count = 0;
+		return count;
+	}
+
+public:
+	typedef uint8_t state_t;
+	static state_t enter() noexcept
+	{
+		if (!depth()++)
+		{
+			while (__atomic_test_and_set(&lock(), __ATOMIC_ACQUIRE))
+				continue;
+		}
+		return 0;
+	}
+
+	static void exit(const state_t) noexcept
+	{
+		if (!--depth())
+			__atomic_clear(&lock(), __ATOMIC_RELEASE);
+	}
+};
+
+typedef spinlockBackend defaultCriticalSectionBackend;
+#else
+/*
+ * Nothing here is safe to assume (eg, bare-metal Cortex-A/R or RISC-V: no PRIMASK, and no threads for a spinlock),
+ * so sections must name their backend, eg criticalSection<myBackend> or atomic<T, myBackend>.
+ */
+typedef noDefaultCriticalSectionBackend defaultCriticalSectionBackend;
+#endif
+
+template<typename backend = defaultCriticalSectionBackend> struct criticalSection
+{
+private:
+	static_assert(!isSame<backend, noDefaultCriticalSectionBackend>::value,
+		"criticalSection: this target has no default backend, one must be chosen explicitly");
+	const typename backend::state_t state;
+
+public:
+	criticalSection() noexcept : state(backend::enter()) { }
+	~criticalSection() noexcept { backend::exit(state); }
+
+	criticalSection(const criticalSection &) = delete;
+	criticalSection(criticalSection &&) = delete;
+	criticalSection &operator =(const criticalSection &) = delete;
+	criticalSection &operator =(criticalSection &&) = delete;
+};
+
+#endif /*__CRITICAL_SECTION_H__*/
@@ -136,4 +136,14 @@ public:
 	}
 };
 
+template<typename T> struct lessThan
+{
+	constexpr bool operator ()(const T &a, const T &b) const noexcept { return a < b; }
+};
+
+template<typename T> struct greaterThan
+{
+	constexpr bool operator ()(const T &a, const T &b) const noexcept { return b < a; }
+};
+
 #endif /*__FUNCTIONAL_H__*/
@@ -0,0 +1,174 @@
+#ifndef __INTRUSIVE_HEAP_H__
+#define __INTRUSIVE_HEAP_H__
+
+#include <stddef.h>
+#include <functional.h>
+
+template<typename T, typename Compare, typename tag> struct intrusiveHeap;
+
+// Derive from heapNode<> to make an object linkable into an intrusiveHeap.
+template<typename tag = void> struct heapNode
+{
+private:
+	heapNode *child;
+	heapNode *next;
+	/*
+	 * The parent for the leftmost child, the previous sibling otherwise, this for the root and nullptr when not linked.
+	 * Not linked being all nullptrs keeps the constructor free of `this`, so static nodes need no dynamic initialisation.
+	 */
+	heapNode *prev;
+
+	template<typename, typename, typename> friend struct intrusiveHeap;
+
+public:
+	constexpr heapNode() noexcept : child(nullptr), next(nullptr), prev(nullptr) { }
+	constexpr bool isLinked() const noexcept { return prev; }
+
+	heapNode(const heapNode &) = delete;
+	heapNode(heapNode &&) = delete;
+	heapNode &operator =(const heapNode &) = delete;
+	heapNode &operator =(heapNode &&) = delete;
+};
+
+/*
+ * Pairing heap over objects deriving from heapNode<tag>, with top() being the element that compares first.
+ * push() is O(1), pop() and remove() are amortised O(log n), and nothing is allocated.
+ */
+template<typename T, typename Compare = lessThan<T>, typename tag = void> struct intrusiveHeap
+{
+private:
+	typedef heapNode<tag> node_t;
+	node_t *root;
+	size_t count;
+	Compare compare;
+
+	bool before(node_t *const a, node_t *const b) const noexcept
+		{ return compare(static_cast<const T &>(*a), static_cast<const T &>(*b)); }
+
+	// Melds two detached trees, returning the new root.
+	node_t *meld(node_t *a, node_t *b) const noexcept
+	{
+		if (!a)
+			return b;
+		else if (!b)
+			return a;
+		if (before(b, a))
+		{
+			node_t *const tmp = a;
+			a = b;
+			b = tmp;
+		}
+		b->prev = a;
+		b->next = a->child;
+		if (a->child)
+			a->child->prev = b;
+		a->child = b;
+		return a;
+	}
+
+	// Standard two pass pairing of a sibling list into a single tree.
+	node_t *mergePairs(node_t *first) const noexcept
+	{
+		node_t *pairs = nullptr;
+		while (first)
+		{
+			node_t *const a = first;
+			node_t *const b = a->next;
+			a->prev = a->next = nullptr;
+			if (!b)
+				first = nullptr;
+			else
+			{
+				first = b->next;
+				b->prev = b->next = nullptr;
+			}
+			node_t *const pair = meld(a, b);
+			pair->next = pairs;
+			pairs = pair;
+		}
+
+		node_t *result = nullptr;
+		while (pairs)
+		{
+			node_t *const pair = pairs;
+			pairs = pair->next;
+			pair->next = nullptr;
+			result = meld(result, pair);
+		}
+		if (result)
+			result->prev = result;
+		return result;
+	}
+
+	static void unlinked(node_t *const node) noexcept
+	{
+		node->child = node->next = node->prev = nullptr;
+	}
+
+public:
+	constexpr intrusiveHeap(const Compare comp = Compare()) noexcept : root(nullptr), count(0), compare(comp) { }
+
+	constexpr size_t size() const noexcept { return count; }
+	constexpr bool empty() const noexcept { return !count; }
+	// top() and pop() must not be used on an empty heap.
+	T &top() const noexcept { return static_cast<T &>(*root); }
+
+	void push(T &value) noexcept
+	{
+		node_t *const node = &value;
+		node->child = node->next = node->prev = nullptr;
+		root = meld(root, node);
+		root->prev = root;
+		++count;
+	}
+
+	T &pop() noexcept
+	{
+		node_t *const node = root;
+		root = mergePairs(node->child);
+		unlinked(node);
+		--count;
+		return static_cast<T &>(*node);
+	}
+
+	// Removes value, which must be in this heap, from wherever it sits in the heap.
+	void remove(T &value) noexcept
+	{
+		node_t *const node = &value;
+		if (node == root)
+		{
+			pop();
+			return;
+		}
+		if (node->prev->child == node)
+			node->prev->child = node->next;
+		else
+			node->prev->next = node->next;
+		if (node->next)
+			node->next->prev = node->prev;
+		root = meld(root, mergePairs(node->child));
+		root->prev = root;
+		unlinked(node);
+		--count;
+	}
+
+	// Call after changing value in a way that affects its ordering.
+	void update(T &value) noexcept
+	{
+		remove(value);
+		push(value);
+	}
+
+	void clear() noexcept
+	{
+		while (root)
+			pop();
+	}
+
+	intrusiveHeap(const intrusiveHeap &) = delete;
+	intrusiveHeap(intrusiveHeap &&) = delete;
+	intrusiveHeap &operator =(const intrusiveHeap &) = delete;
+	intrusiveHeap &operator =(intrusiveHeap &&) = delete;
+};
+
+#endif /*__INTRUSIVE_HEAP_H__*/
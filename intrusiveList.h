@@ -0,0 +1,174 @@
+#ifndef __INTRUSIVE_LIST_H__
+#define __INTRUSIVE_LIST_H__
+
+#include <stddef.h>
+
+template<typename T, typename tag> struct intrusiveList;
+
+/*
+ * Derive from listNode<> to make an object linkable into an intrusiveList.
+ * An object that needs to sit on several lists at once derives from one listNode per list, each with a distinct tag type.
+ */
+template<typename tag = void> struct listNode
+{
+private:
+	listNode *prev;
+	listNode *next;
+
+	template<typename, typename> friend struct intrusiveList;
+
+public:
+	constexpr listNode() noexcept : prev(nullptr), next(nullptr) { }
+	constexpr bool isLinked() const noexcept { return prev; }
+
+	listNode(const listNode &) = delete;
+	listNode(listNode &&) = delete;
+	listNode &operator =(const listNode &) = delete;
+	listNode &operator =(listNode &&) = delete;
+};
+
+/*
+ * Doubly-linked list over objects deriving from listNode<tag>. Nothing is allocated - the list only links the nodes.
+ * Removal is O(1) and leaves the removed node's forward link intact, so the element an iterator is on can be removed
+ * while iterating. It must not be relinked (eg, moved to another list) before the iterator advances though,
+ * as the iterator would then follow it - use forEach() or removeIf() for that.
+ */
+template<typename T, typename tag = void> struct intrusiveList
+{
+private:
+	typedef listNode<tag> node_t;
+	// The list is circular through this sentinel, so no operation needs to special case the ends.
+	node_t head;
+	size_t count;
+
+	static T &value(node_t *const node) noexcept { return static_cast<T &>(*node); }
+
+	static void linkBefore(node_t *const where, node_t *const node) noexcept
+	{
+		node->prev = where->prev;
+		node->next = where;
+		where->prev->next = node;
+		where->prev = node;
+	}
+
+public:
+	template<typename U, typename N> struct iteratorType
+	{
+	private:
+		N *node;
+		friend struct intrusiveList;
+
+	public:
+		constexpr iteratorType(N *const n) noexcept : node(n) { }
+		U &operator *() const noexcept { return static_cast<U &>(*node); }
+		U *operator ->() const noexcept { return &static_cast<U &>(*node); }
+		iteratorType &operator ++() noexcept { node = node->next; return *this; }
+		iteratorType operator ++(int) noexcept { iteratorType it(*this); node = node->next; return it; }
+		iteratorType &operator --() noexcept { node = node->prev; return *this; }
+		iteratorType operator --(int) noexcept { iteratorType it(*this); node = node->prev; return it; }
+		constexpr bool operator ==(const iteratorType &it) const noexcept { return node == it.node; }
+		constexpr bool operator !=(const iteratorType &it) const noexcept { return node != it.node; }
+	};
+	typedef iteratorType<T, node_t> iterator;
+	typedef iteratorType<const T, const node_t> constIterator;
+
+	intrusiveList() noexcept : count(0) { head.prev = head.next = &head; }
+	~intrusiveList() noexcept { clear(); }
+
+	constexpr size_t size() const noexcept { return count; }
+	constexpr bool empty() const noexcept { return !count; }
+
+	iterator begin() noexcept { return iterator(head.next); }
+	constIterator begin() const noexcept { return constIterator(head.next); }
+	iterator end() noexcept { return iterator(&head); }
+	constIterator end() const noexcept { return constIterator(&head); }
+
+	// These, and popFront()/popBack(), must not be used on an empty list.
+	T &front() noexcept { return value(head.next); }
+	T &back() noexcept { return value(head.prev); }
+
+	// Links value in before where. value must not already be on a list using this tag.
+	iterator insert(const iterator where, T &value) noexcept
+	{
+		node_t *const node = &value;
+		linkBefore(where.node, node);
+		++count;
+		return iterator(node);
+	}
+
+	void pushFront(T &value) noexcept { insert(begin(), value); }
+	void pushBack(T &value) noexcept { insert(end(), value); }
+
+	// Unlinks value, which must be on this list, returning an iterator to the element that followed it.
+	iterator remove(T &value) noexcept
+	{
+		node_t *const node = &value;
+		node_t *const next = node->next;
+		node->prev->next = next;
+		next->prev = node->prev;
+		node->prev = nullptr;
+		--count;
+		return iterator(next);
+	}
+
+	iterator erase(const iterator where) noexcept { return remove(*where); }
+
+	T &popFront() noexcept
+	{
+		T &value = front();
+		remove(value);
+		return value;
+	}
+
+	T &popBack() noexcept
+	{
+		T &value = back();
+		remove(value);
+		return value;
+	}
+
+	/*
+	 * Calls fn on each element in turn. fn may remove the element it is handed and relink it anywhere,
+	 * including onto another list, as the following element is found before fn is called.
+	 * fn must not remove any other element of this list.
+	 */
+	template<typename F> void forEach(F &&fn) noexcept
+	{
+		for (node_t *node = head.next, *next; node != &head; node = next)
+		{
+			next = node->next;
+			fn(value(node));
+		}
+	}
+
+	// Removes every element pred returns true for, returning how many were removed.
+	template<typename Pred> size_t removeIf(Pred &&pred) noexcept
+	{
+		size_t removed = 0;
+		for (node_t *node = head.next, *next; node != &head; node = next)
+		{
+			next = node->next;
+			if (pred(static_cast<const T &>(value(node))))
+			{
+				remove(value(node));
+				++removed;
+			}
+		}
+		return removed;
+	}
+
+	void clear() noexcept
+	{
+		for (node_t *node = head.next; node != &head; node = node->next)
+			node->prev = nullptr;
+		head.prev = head.next = &head;
+		count = 0;
+	}
+
+	intrusiveList(const intrusiveList &) = delete;
+	intrusiveList(intrusiveList &&) = delete;
+	intrusiveList &operator =(const intrusiveList &) = delete;
+	intrusiveList &operator =(intrusiveList &&) = delete;
+};
+
+#endif /*__INTRUSIVE_LIST_H__*/
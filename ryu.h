@@ -0,0 +1,287 @@
+#ifndef __RYU_H__
+#define __RYU_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Shortest round-trip float to decimal conversion, after Ulf Adams' Ryu (PLDI 2018).
+ * This is the 32-bit variant which only needs two small tables of 5^n approximations and no libm.
+ * The result is mantissa * 10^exponent with the fewest digits that still parses back to the same float.
+ */
+struct floatDecimal_t
+{
+	uint32_t mantissa;
+	int32_t exponent;
+};
+
+template<typename = void> struct __ryu
+{
+private:
+	static constexpr uint8_t mantissaBits = 23;
+	static constexpr int32_t bias = 127;
+	static constexpr int32_t pow5InvBitCount = 59;
+	static constexpr int32_t pow5BitCount = 61;
+	static constexpr uint64_t pow5InvSplit[31] =
+	{
+		576460752303423489u, 461168601842738791u, 368934881474191033u,
+		295147905179352826u, 472236648286964522u, 377789318629571618u,
+		302231454903657294u, 483570327845851670u, 386856262276681336u,
+		309485009821345069u, 495176015714152110u, 396140812571321688u,
+		316912650057057351u, 507060240091291761u, 405648192073033409u,
+		324518553658426727u, 519229685853482763u, 415383748682786211u,
+		332306998946228969u, 531691198313966350u, 425352958651173080u,
+		340282366920938464u, 544451787073501542u, 435561429658801234u,
+		348449143727040987u, 557518629963265579u, 446014903970612463u,
+		356811923176489971u, 570899077082383953u, 456719261665907162u,
+		365375409332725730u,
+	};
+	static constexpr uint64_t pow5Split[47] =
+	{
+		1152921504606846976u, 1441151880758558720u, 1801439850948198400u,
+		2251799813685248000u, 1407374883553280000u, 1759218604441600000u,
+		2199023255552000000u, 1374389534720000000u, 1717986918400000000u,
+		2147483648000000000u, 1342177280000000000u, 1677721600000000000u,
+		2097152000000000000u, 1310720000000000000u, 1638400000000000000u,
+		2048000000000000000u, 1280000000000000000u, 1600000000000000000u,
+		2000000000000000000u, 1250000000000000000u, 1562500000000000000u,
+		1953125000000000000u, 1220703125000000000u, 1525878906250000000u,
+		1907348632812500000u, 1192092895507812500u, 1490116119384765625u,
+		1862645149230957031u, 1164153218269348144u, 1455191522836685180u,
+		1818989403545856475u, 2273736754432320594u, 1421085471520200371u,
+		1776356839400250464u, 2220446049250313080u, 1387778780781445675u,
+		1734723475976807094u, 2168404344971008868u, 1355252715606880542u,
+		1694065894508600678u, 2117582368135750847u, 1323488980084844279u,
+		1654361225106055349u, 2067951531382569187u, 1292469707114105741u,
+		1615587133892632177u, 2019483917365790221u,
+	};
+
+	// ceil(log2(5^e)) for e > 0, and 1 for e == 0
+	static constexpr int32_t pow5Bits(const int32_t e) noexcept { return int32_t((uint32_t(e) * 1217359) >> 19) + 1; }
+	static constexpr uint32_t log10Pow2(const int32_t e) noexcept { return (uint32_t(e) * 78913) >> 18; }
+	static constexpr uint32_t log10Pow5(const int32_t e) noexcept { return (uint32_t(e) * 732923) >> 20; }
+
+	static uint32_t pow5Factor(uint32_t value) noexcept
+	{
+		uint32_t count = 0;
+		for (; value % 5 == 0; value /= 5)
+			++count;
+		return count;
+	}
+
+	static bool multipleOfPowerOf5(const uint32_t value, const uint32_t p) noexcept { return pow5Factor(value) >= p; }
+	static bool multipleOfPowerOf2(const uint32_t value, const uint32_t p) noexcept { return !(value & ((uint32_t(1) << p) - 1)); }
+
+	// Just enough multi-precision arithmetic to compare a float exactly against a decimal - under 160 bits are ever needed.
+	static constexpr size_t limbCount = 6;
+
+	static void multiply(uint32_t *const value, const uint32_t factor) noexcept
+	{
+		uint64_t carry = 0;
+		for (size_t i = 0; i < limbCount; ++i)
+		{
+			carry += uint64_t(value[i]) * factor;
+			value[i] = uint32_t(carry);
+			carry >>= 32;
+		}
+	}
+
+	static void multiplyPow5(uint32_t *const value, uint32_t power) noexcept
+	{
+		// 5^13 is the largest power of 5 that fits in 32 bits.
+		for (; power >= 13; power -= 13)
+			multiply(value, 1220703125U);
+		uint32_t factor = 1;
+		for (; power; --power)
+			factor *= 5;
+		multiply(value, factor);
+	}
+
+	static void shiftLeft(uint32_t *const value, const uint32_t bits) noexcept
+	{
+		const size_t words = bits / 32;
+		const uint32_t shift = bits % 32;
+		for (size_t i = limbCount; i-- > 0; )
+		{
+			uint32_t limb = i >= words ? value[i - words] << shift : 0;
+			if (shift && i > words)
+				limb |= value[i - words - 1] >> (32 - shift);
+			value[i] = limb;
+		}
+	}
+
+	// Computes (m * factor) >> shift using only 32x32->64 multiplies.
+	static uint32_t mulShift(const uint32_t m, const uint64_t factor, const int32_t shift) noexcept
+	{
+		const uint64_t low = uint64_t(m) * uint32_t(factor);
+		const uint64_t high = uint64_t(m) * uint32_t(factor >> 32);
+		return uint32_t(((low >> 32) + high) >> (shift - 32));
+	}
+
+public:
+	[[gnu::noinline]] static floatDecimal_t toDecimal(const uint32_t ieeeMantissa, const uint32_t ieeeExponent) noexcept
+	{
+		int32_t e2;
+		uint32_t m2;
+		if (ieeeExponent == 0)
+		{
+			e2 = 1 - bias - mantissaBits - 2;
+			m2 = ieeeMantissa;
+		}
+		else
+		{
+			e2 = int32_t(ieeeExponent) - bias - mantissaBits - 2;
+			m2 = (uint32_t(1) << mantissaBits) | ieeeMantissa;
+		}
+		const bool acceptBounds = !(m2 & 1);
+
+		// Determine the interval of valid decimal representations, scaled by 4.
+		const uint32_t mv = 4 * m2;
+		const uint32_t mp = 4 * m2 + 2;
+		const uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+		const uint32_t mm = 4 * m2 - 1 - mmShift;
+
+		// Convert the interval to a decimal power base.
+		uint32_t vr, vp, vm;
+		int32_t e10;
+		bool vmIsTrailingZeros = false;
+		bool vrIsTrailingZeros = false;
+		uint8_t lastRemovedDigit = 0;
+		if (e2 >= 0)
+		{
+			const uint32_t q = log10Pow2(e2);
+			e10 = int32_t(q);
+			const int32_t k = pow5InvBitCount + pow5Bits(int32_t(q)) - 1;
+			const int32_t i = -e2 + int32_t(q) + k;
+			vr = mulShift(mv, pow5InvSplit[q], i);
+			vp = mulShift(mp, pow5InvSplit[q], i);
+			vm = mulShift(mm, pow5InvSplit[q], i);
+			if (q != 0 && (vp - 1) / 10 <= vm / 10)
+			{
+				// We need to know one removed digit even if we are not going to loop below.
+				const int32_t l = pow5InvBitCount + pow5Bits(int32_t(q - 1)) - 1;
+				lastRemovedDigit = uint8_t(mulShift(mv, pow5InvSplit[q - 1], -e2 + int32_t(q) - 1 + l) % 10);
+			}
+			if (q <= 9)
+			{
+				// Only one of mp, mv, and mm can be a multiple of 5, if any.
+				if (mv % 5 == 0)
+					vrIsTrailingZeros = multipleOfPowerOf5(mv, q);
+				else if (acceptBounds)
+					vmIsTrailingZeros = multipleOfPowerOf5(mm, q);
+				else
+					vp -= multipleOfPowerOf5(mp, q);
+			}
+		}
+		else
+		{
+			const uint32_t q = log10Pow5(-e2);
+			e10 = int32_t(q) + e2;
+			const int32_t i = -e2 - int32_t(q);
+			const int32_t k = pow5Bits(i) - pow5BitCount;
+			int32_t j = int32_t(q) - k;
+			vr = mulShift(mv, pow5Split[i], j);
+			vp = mulShift(mp, pow5Split[i], j);
+			vm = mulShift(mm, pow5Split[i], j);
+			if (q != 0 && (vp - 1) / 10 <= vm / 10)
+			{
+				j = int32_t(q) - 1 - (pow5Bits(i + 1) - pow5BitCount);
+				lastRemovedDigit = uint8_t(mulShift(mv, pow5Split[i + 1], j) % 10);
+			}
+			if (q <= 1)
+			{
+				// mv = 4 * m2, so it always has at least two trailing 0 bits.
+				vrIsTrailingZeros = true;
+				if (acceptBounds)
+					vmIsTrailingZeros = mmShift == 1;
+				else
+					--vp;
+			}
+			else if (q < 31)
+				vrIsTrailingZeros = multipleOfPowerOf2(mv, q - 1);
+		}
+
+		// Find the shortest decimal representation in the interval.
+		int32_t removed = 0;
+		uint32_t output;
+		if (vmIsTrailingZeros || vrIsTrailingZeros)
+		{
+			// The rare (~4%) general case.
+			while (vp / 10 > vm / 10)
+			{
+				vmIsTrailingZeros &= vm % 10 == 0;
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				lastRemovedDigit = uint8_t(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				++removed;
+			}
+			if (vmIsTrailingZeros)
+			{
+				while (vm % 10 == 0)
+				{
+					vrIsTrailingZeros &= lastRemovedDigit == 0;
+					lastRemovedDigit = uint8_t(vr % 10);
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++removed;
+				}
+			}
+			// Round to even if the exact number is .....50..0.
+			if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+				lastRemovedDigit = 4;
+			// Take vr + 1 if vr is outside the bounds or we need to round up.
+			output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+		}
+		else
+		{
+			while (vp / 10 > vm / 10)
+			{
+				lastRemovedDigit = uint8_t(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				++removed;
+			}
+			output = vr + (vr == vm || lastRemovedDigit >= 5);
+		}
+		return {output, e10 + removed};
+	}
+
+	// Compares the exact value of the float with decimal.mantissa * 10^decimal.exponent, giving -1, 0 or 1.
+	static int8_t compare(const uint32_t ieeeMantissa, const uint32_t ieeeExponent, const floatDecimal_t decimal) noexcept
+	{
+		const int32_t e2 = ieeeExponent ? int32_t(ieeeExponent) - bias - mantissaBits : 1 - bias - mantissaBits;
+		uint32_t value[limbCount] = {ieeeExponent ? (uint32_t(1) << mantissaBits) | ieeeMantissa : ieeeMantissa};
+		uint32_t other[limbCount] = {decimal.mantissa};
+		// Scale both sides up to integers: m2 * 2^e2 against m10 * 5^e10 * 2^e10.
+		if (decimal.exponent < 0)
+			multiplyPow5(value, uint32_t(-decimal.exponent));
+		else
+			multiplyPow5(other, uint32_t(decimal.exponent));
+		if (e2 > decimal.exponent)
+			shiftLeft(value, uint32_t(e2 - decimal.exponent));
+		else
+			shiftLeft(other, uint32_t(decimal.exponent - e2));
+		for (size_t i = limbCount; i-- > 0; )
+		{
+			if (value[i] != other[i])
+				return value[i] < other[i] ? -1 : 1;
+		}
+		return 0;
+	}
+};
+template<typename T> constexpr uint64_t __ryu<T>::pow5InvSplit[31];
+template<typename T> constexpr uint64_t __ryu<T>::pow5Split[47];
+
+// Only meaningful for finite, non-zero values - the caller handles sign, zero, inf and NaN from the raw bits.
+inline floatDecimal_t floatToDecimal(const uint32_t bits) noexcept
+	{ return __ryu<>::toDecimal(bits & 0x007FFFFF, (bits >> 23) & 0xFF); }
+
+// Exactly compares the magnitude of a finite float with decimal.mantissa * 10^decimal.exponent, giving -1, 0 or 1.
+inline int8_t compareFloatToDecimal(const uint32_t bits, const floatDecimal_t decimal) noexcept
+	{ return __ryu<>::compare(bits & 0x007FFFFF, (bits >> 23) & 0xFF, decimal); }
+
+#endif /*__RYU_H__*/
@@ -5,6 +5,8 @@
 #include <utility.h>
 #include <array.h>
 #include <functional.h>
+#include <ryu.h>
+#include <stringView.h>
 
 struct outDev
 {
@@ -36,101 +38,381 @@ public:
 		while (*str != 0)
 			vtable->write(instance, *str++);
 	}
-};
 
-struct printable_t { };
+	void write(const char *str, size_t length) noexcept
+	{
+		for (; length; --length)
+			vtable->write(instance, *str++);
+	}
+};
 
-template<uint8_t pad = 0, uint8_t padChar = ' '> struct asHex : public printable_t
+/*
+ * outDev that formats into RAM so a message can be built up and then sent in one transfer.
+ * Output past the end of the buffer is dropped, but still counted so the caller can tell how much room was needed.
+ */
+struct bufferOutDev : public outDev
 {
 private:
-	static constexpr uint8_t padding = pad;
-	const uint8_t maxDigits;
-	const uint8_t msbShift;
-	const uint32_t number;
+	char *const buffer;
+	const size_t capacity;
+	size_t used;
+	size_t needed;
+
+	void initFn(const uint32_t) noexcept { reset(); }
+
+	void writeFn(const char c) noexcept
+	{
+		if (used < capacity)
+			buffer[used++] = c;
+		++needed;
+	}
+
+	// A template only so the table can be defined in this header without an ODR violation.
+	template<typename = void> struct vtable_t
+	{
+		static constexpr functions fns{init_t::make<bufferOutDev, &bufferOutDev::initFn>(),
+			write_t::make<bufferOutDev, &bufferOutDev::writeFn>()};
+	};
 
 public:
-	template<typename T> constexpr asHex(const T value) noexcept : maxDigits(sizeof(T) * 2), msbShift(4 * (maxDigits - 1)), number(value) { }
+	bufferOutDev(char *const storage, const size_t length) noexcept : outDev(&vtable_t<>::fns, this),
+		buffer(storage), capacity(length), used(0), needed(0) { }
+	template<size_t N> bufferOutDev(array<char, N> &storage) noexcept : bufferOutDev(storage.data(), N) { }
+	bufferOutDev(arrayAt &region) noexcept : bufferOutDev(region.as<char>().begin(), region.size()) { }
+
+	void reset() noexcept { used = needed = 0; }
+	size_t size() const noexcept { return capacity; }
+	size_t length() const noexcept { return used; }
+	// The length the output would have had with an unlimited buffer.
+	size_t required() const noexcept { return needed; }
+	bool truncated() const noexcept { return needed > used; }
+	const char *data() const noexcept { return buffer; }
+	stringView view() const noexcept { return stringView(buffer, used); }
+
+	bufferOutDev() = delete;
+	bufferOutDev(const bufferOutDev &) = delete;
+	bufferOutDev(bufferOutDev &&) = delete;
+	bufferOutDev &operator =(const bufferOutDev &) = delete;
+	bufferOutDev &operator =(bufferOutDev &&) = delete;
+};
+template<typename T> constexpr outDev::functions bufferOutDev::vtable_t<T>::fns;
+
+struct printable_t { };
+
+/*
+ * The formatters below are split into shared, type-independent cores and thin typed shims,
+ * so each new integer type or padding combination only instantiates a call into the core.
+ */
 
-	[[gnu::noinline]]
-	void operator ()(outDev &dev)
+// Writes value's decimal digits so they end just before end, and returns where they start.
+inline char *__formatDigits(char *end, uint32_t value) noexcept
+{
+	do
 	{
-		uint8_t i;
-		uint32_t value(number);
-		// If we've been asked to pad by more than the maximum possible length of the number
-		if (maxDigits < pad)
-		{
-			// Put out the excess padding early to keep the logic simple.
-			for (i = 0; i < (pad - maxDigits); ++i)
-				dev.write(padChar);
-		}
+		*--end = char('0' + (value % 10));
+		value /= 10;
+	}
+	while (value);
+	return end;
+}
 
-		// For up to the maximum number of digits, pad as needed
-		for (i = maxDigits; i > 1; i--)
-		{
-			const uint8_t nibble = uint8_t((value >> msbShift) & 0x0F);
-			if (nibble == 0)
-				value <<= 4;
-			if (i > pad && nibble == 0)
-				continue;
-			else if (i <= pad && nibble == 0)
-				dev.write(padChar);
-			else
-				break;
-			// If 0 and pad == 0, we don't output anything here.
-		}
+inline char *__formatDigits(char *end, uint64_t value) noexcept
+{
+	// Only use 64-bit division for as long as the value actually needs it.
+	for (; value > UINT32_MAX; value /= 10)
+		*--end = char('0' + (value % 10));
+	return __formatDigits(end, uint32_t(value));
+}
 
-		for (; i > 0; --i)
-		{
-			const uint8_t nibble = uint8_t((value >> msbShift) & 0x0F);
-			const uint8_t ch = nibble + '0';
-			if (ch > '9')
-				dev.write(ch + 7);
-			else
-				dev.write(ch);
-			value <<= 4;
-		}
+[[gnu::noinline]] inline void __formatHex(outDev &dev, uint32_t value, const uint8_t pad, const char padChar) noexcept
+{
+	char digits[8];
+	char *const end = digits + sizeof(digits);
+	char *start = end;
+	do
+	{
+		const uint8_t nibble = value & 0x0F;
+		*--start = char(nibble < 10 ? '0' + nibble : 'A' - 10 + nibble);
+		value >>= 4;
+	}
+	while (value);
+
+	for (uint8_t count = uint8_t(end - start); count < pad; ++count)
+		dev.write(padChar);
+	dev.write(start, end - start);
+}
+
+// Only the high half is padded, the low half then always takes all 8 of its digits.
+[[gnu::noinline]] inline void __formatHex(outDev &dev, const uint64_t value, const uint8_t pad, const char padChar) noexcept
+{
+	const uint32_t high = uint32_t(value >> 32);
+	if (!high)
+		return __formatHex(dev, uint32_t(value), pad, padChar);
+	__formatHex(dev, high, pad > 8 ? uint8_t(pad - 8) : 0, padChar);
+	__formatHex(dev, uint32_t(value), 8, '0');
+}
+
+[[gnu::noinline]] inline void __formatInt(outDev &dev, const bool negative, const uint32_t value) noexcept
+{
+	char buffer[11];
+	char *const end = buffer + sizeof(buffer);
+	char *start = __formatDigits(end, value);
+	if (negative)
+		*--start = '-';
+	dev.write(start, end - start);
+}
+
+[[gnu::noinline]] inline void __formatInt(outDev &dev, const bool negative, const uint64_t value) noexcept
+{
+	char buffer[21];
+	char *const end = buffer + sizeof(buffer);
+	char *start = __formatDigits(end, value);
+	if (negative)
+		*--start = '-';
+	dev.write(start, end - start);
+}
+
+template<uint8_t pad = 0, uint8_t padChar = ' '> struct asHex : public printable_t
+{
+private:
+	const uint32_t low;
+	const uint32_t high;
+
+public:
+	/*
+	 * Only the bytes of T are kept, so narrow signed values are not printed sign-extended out to 8 digits.
+	 * high is a constant 0 for T of up to 32 bits, so once inlined those never reference the 64-bit core.
+	 */
+	template<typename T> constexpr asHex(const T value) noexcept : low(uint32_t(value) &
+		(sizeof(T) < sizeof(uint32_t) ? (uint32_t(1) << (sizeof(T) * 8)) - 1 : UINT32_MAX)),
+		high(sizeof(T) > sizeof(uint32_t) ? uint32_t(uint64_t(value) >> 32) : 0) { }
+	void operator ()(outDev &dev) noexcept
+	{
+		if (high)
+			__formatHex(dev, (uint64_t(high) << 32) | low, pad, padChar);
+		else
+			__formatHex(dev, low, pad, padChar);
 	}
 };
 
 template<typename N> struct asInt : public printable_t
 {
 private:
+	static_assert(isIntegral<N>::value && !isBoolean<N>::value, "asInt: N must be a non-boolean integer type");
 	typedef typename makeUnsigned<N>::type UInt;
+	// Everything up to 32 bits shares the one core, so only 64-bit types pull in 64-bit division.
+	typedef typename conditional<sizeof(UInt) <= sizeof(uint32_t), uint32_t, uint64_t>::type Value;
 	const N number;
 
-	[[gnu::noinline]] UInt print(const UInt number, outDev &dev) noexcept
+	constexpr bool negative() const noexcept { return isSigned<N>::value && number < N(0); }
+
+public:
+	constexpr asInt(const N value) noexcept : number(value) { }
+	void operator ()(outDev &dev) noexcept
+		{ __formatInt(dev, negative(), Value(negative() ? UInt(UInt(0) - UInt(number)) : UInt(number))); }
+};
+
+// Formats a fixed-point magnitude into buffer, which must be at least 48 characters long.
+[[gnu::noinline]] inline void __formatFixed(char *buffer, const bool negative, uint32_t integer,
+	uint64_t fraction, const uint8_t fracBits, const uint8_t precision) noexcept
+{
+	const uint64_t fracMask = (uint64_t(1) << fracBits) - 1;
+	char digits[32];
+	uint8_t count = 0;
+	// With precision 0, print every digit - k / 2^n always terminates within n decimal digits.
+	const uint8_t maxDigits = precision ? precision : fracBits;
+	while (count < maxDigits && (precision || fraction))
 	{
-		if (number < 10)
-			dev.write(number + '0');
-		else
+		fraction *= 10;
+		digits[count++] = char('0' + (fraction >> fracBits));
+		fraction &= fracMask;
+	}
+
+	// Round half up on the first dropped digit, carrying into the integer part if needed.
+	if (precision && (fraction << 1) > fracMask)
+	{
+		uint8_t i = count;
+		for (; i > 0; --i)
 		{
-			const UInt num = number - (print(number / 10, dev) * 10);
-			dev.write(num + '0');
+			if (digits[i - 1] != '9')
+			{
+				++digits[i - 1];
+				break;
+			}
+			digits[i - 1] = '0';
 		}
-		return number;
+		if (!i)
+			++integer;
 	}
 
-	template<typename T> typename enableIf<isSame<T, N>::value && isIntegral<T>::value && !isBoolean<T>::value && isUnsigned<T>::value>::type
-		format(outDev &dev)
+	char intDigits[10];
+	const char *const intEnd = intDigits + sizeof(intDigits);
+	const char *intStart = __formatDigits(intDigits + sizeof(intDigits), integer);
+	if (negative)
+		*buffer++ = '-';
+	while (intStart != intEnd)
+		*buffer++ = *intStart++;
+	if (count)
 	{
-		print(number, dev);
+		*buffer++ = '.';
+		for (uint8_t i = 0; i < count; ++i)
+			*buffer++ = digits[i];
 	}
+	*buffer = 0;
+}
 
-	template<typename T> [[gnu::noinline]] typename enableIf<isSame<T, N>::value && isIntegral<T>::value && !isBoolean<T>::value && isSigned<T>::value>::type
-		format(outDev &dev)
+// Formats the float with the given bit pattern into buffer, which must be at least 24 characters long.
+[[gnu::noinline]] inline void __formatFloat(char *buffer, const uint32_t bits, const uint8_t precision) noexcept
+{
+	const uint32_t exponent = (bits >> 23) & 0xFF;
+	const uint32_t mantissa = bits & 0x007FFFFF;
+	if (exponent == 0xFF && mantissa)
+	{
+		__builtin_memcpy(buffer, "nan", 4);
+		return;
+	}
+	if (bits >> 31)
+		*buffer++ = '-';
+	if (exponent == 0xFF)
 	{
-		if (number < 0)
+		__builtin_memcpy(buffer, "inf", 4);
+		return;
+	}
+	else if (!exponent && !mantissa)
+	{
+		__builtin_memcpy(buffer, "0", 2);
+		return;
+	}
+
+	floatDecimal_t decimal = floatToDecimal(bits);
+	char digits[10];
+	char *const digitsEnd = digits + sizeof(digits);
+	const char *digitsStart = __formatDigits(digitsEnd, decimal.mantissa);
+	int32_t count = int32_t(digitsEnd - digitsStart);
+	if (precision && count > precision)
+	{
+		/*
+		 * Round to the requested number of significant digits. The shortest digits can only round differently
+		 * to the exact value when they end on a tie (...5), as any closer boundary would itself be a shorter
+		 * representation - so just that case is settled against the exact value, halves going to even.
+		 */
+		uint32_t divisor = 1;
+		for (int32_t i = precision; i < count; ++i)
+			divisor *= 10;
+		const uint32_t remainder = decimal.mantissa % divisor;
+		const uint32_t rounded = decimal.mantissa / divisor;
+		int8_t direction = remainder < divisor - remainder ? -1 : remainder > divisor - remainder ? 1 : 0;
+		if (!direction)
+			direction = compareFloatToDecimal(bits, decimal);
+		decimal.mantissa = rounded + (direction > 0 || (!direction && (rounded & 1)));
+		decimal.exponent += count - precision;
+	}
+	while (!(decimal.mantissa % 10))
+	{
+		decimal.mantissa /= 10;
+		++decimal.exponent;
+	}
+	digitsStart = __formatDigits(digitsEnd, decimal.mantissa);
+	count = int32_t(digitsEnd - digitsStart);
+
+	// point is where the decimal point falls relative to the first digit.
+	const int32_t point = count + decimal.exponent;
+	if (point > 9 || point < -4)
+	{
+		*buffer++ = *digitsStart++;
+		if (count > 1)
 		{
-			dev.write('-');
-			print((typename makeUnsigned<N>::type)-number, dev);
+			*buffer++ = '.';
+			while (digitsStart != digitsEnd)
+				*buffer++ = *digitsStart++;
+		}
+		*buffer++ = 'e';
+		int32_t power = point - 1;
+		if (power < 0)
+		{
+			*buffer++ = '-';
+			power = -power;
+		}
+		char powerDigits[2];
+		const char *powerStart = __formatDigits(powerDigits + sizeof(powerDigits), uint32_t(power));
+		while (powerStart != powerDigits + sizeof(powerDigits))
+			*buffer++ = *powerStart++;
+	}
+	else if (point <= 0)
+	{
+		*buffer++ = '0';
+		*buffer++ = '.';
+		for (int32_t i = point; i < 0; ++i)
+			*buffer++ = '0';
+		while (digitsStart != digitsEnd)
+			*buffer++ = *digitsStart++;
+	}
+	else
+	{
+		const char *const pointAt = point < count ? digitsStart + point : digitsEnd;
+		while (digitsStart != pointAt)
+			*buffer++ = *digitsStart++;
+		for (int32_t i = count; i < point; ++i)
+			*buffer++ = '0';
+		if (digitsStart != digitsEnd)
+		{
+			*buffer++ = '.';
+			while (digitsStart != digitsEnd)
+				*buffer++ = *digitsStart++;
 		}
-		else
-			print((typename makeUnsigned<N>::type)number, dev);
 	}
+	*buffer = 0;
+}
+
+/*
+ * Prints a fixed-point value with fracBits fractional bits (eg, asFixed<16>(q16_16)).
+ * A precision of 0 prints the exact value, otherwise the value is rounded to precision decimal places.
+ */
+template<uint8_t fracBits, uint8_t precision = 0> struct asFixed : public printable_t
+{
+private:
+	static_assert(fracBits <= 32, "asFixed: at most 32 fractional bits are supported");
+	static_assert(precision <= 32, "asFixed: at most 32 decimal places are supported");
+	const bool negative;
+	const uint32_t magnitude;
 
 public:
-	constexpr asInt(const N value) noexcept : number(value) { }
-	void operator ()(outDev &dev) noexcept { format<N>(dev); }
+	template<typename T> constexpr asFixed(const T value) noexcept : negative(value < T(0)),
+		magnitude(value < T(0) ? uint32_t(0) - uint32_t(value) : uint32_t(value))
+	{
+		static_assert(isIntegral<T>::value && sizeof(T) <= sizeof(uint32_t), "asFixed: value must be an integer of at most 32 bits");
+	}
+
+	void operator ()(outDev &dev) noexcept
+	{
+		char buffer[48];
+		const uint32_t integer = fracBits == 32 ? 0 : uint32_t(uint64_t(magnitude) >> fracBits);
+		__formatFixed(buffer, negative, integer, magnitude & ((uint64_t(1) << fracBits) - 1), fracBits, precision);
+		dev.write(buffer);
+	}
+};
+
+/*
+ * Prints a float using the shortest decimal that round-trips to the same value.
+ * A non-zero precision instead limits the output to that many significant digits.
+ */
+template<uint8_t precision = 0> struct asFloat : public printable_t
+{
+private:
+	static_assert(precision <= 9, "asFloat: a float never needs more than 9 significant digits");
+	const float number;
+
+public:
+	constexpr asFloat(const float value) noexcept : number(value) { }
+
+	void operator ()(outDev &dev) noexcept
+	{
+		char buffer[24];
+		uint32_t bits;
+		__builtin_memcpy(&bits, &number, sizeof(bits));
+		__formatFloat(buffer, bits, precision);
+		dev.write(buffer);
+	}
 };
 
 template<typename> struct isChar : falseType { };
@@ -146,6 +428,8 @@ private:
 	void print(const char *value) noexcept { dev.write(value); }
 	/*void print(function<void(outDev &)> callable) noexcept { callable(dev); }*/
 	void print(const char value) noexcept { dev.write(value); }
+	void print(const float value) noexcept { write(asFloat<>(value)); }
+	void print(const stringView &value) noexcept { dev.write(value.data(), value.size()); }
 
 	template<typename T> typename enableIf<isBaseOf<printable_t, T>::value>::type
 		print(T &printable) noexcept { printable(dev); }
@@ -155,7 +439,7 @@ private:
 
 	template<typename T> void print(T *ptr) noexcept
 	{
-		write("0x", asHex<8, '0'>((const long)ptr));
+		write("0x", asHex<sizeof(T *) * 2, '0'>(uintptr_t(ptr)));
 	}
 
 	void print(const bool value) noexcept
@@ -0,0 +1,34 @@
+#ifndef __STRING_VIEW_H__
+#define __STRING_VIEW_H__
+
+#include <stddef.h>
+
+struct stringView
+{
+public:
+	typedef const char *iterator;
+	typedef const char *constIterator;
+
+private:
+	const char *str;
+	size_t len;
+
+public:
+	constexpr stringView() noexcept : str(nullptr), len(0) { }
+	constexpr stringView(const char *const value, const size_t length) noexcept : str(value), len(length) { }
+
+	constexpr size_t size() const noexcept { return len; }
+	constexpr bool empty() const noexcept { return !len; }
+	constexpr const char *data() const noexcept { return str; }
+	constexpr constIterator begin() const noexcept { return str; }
+	constexpr constIterator end() const noexcept { return begin() + size(); }
+
+	constexpr char operator [](const size_t index) const noexcept
+		{ return index < len ? str[index] : 0; }
+};
+
+// "text"_sv - views a string literal, taking its length from the compiler rather than scanning for the NUL.
+constexpr inline stringView operator ""_sv(const char *const value, const size_t length) noexcept
+	{ return stringView(value, length); }
+
+#endif /*__STRING_VIEW_H__*/
@@ -0,0 +1,236 @@
+#ifndef __TEE_OUT_DEV_H__
+#define __TEE_OUT_DEV_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array.h>
+#include <atomic.h>
+#include <stdout.h>
+
+enum class severity : uint8_t
+{
+	trace,
+	debug,
+	info,
+	warning,
+	error,
+	fatal
+};
+
+// What a teeOutDev does with a block when a sink does not have room for all of it.
+enum class overflowPolicy : uint8_t
+{
+	/*
+	 * Drop the block for this sink only, so a slow sink never holds up the others.
+	 * Once part of a line has been dropped the rest of it is too, so a sink never sees a line missing its start.
+	 * A block bigger than the sink could ever hold is cut down to what fits instead, as it would otherwise never get through.
+	 */
+	drop,
+	// Wait for the sink to drain, for sinks that must see everything.
+	block
+};
+
+/*
+ * Sinks are any type providing:
+ *	size_t available() const noexcept - how many bytes can be accepted right now without blocking
+ *	size_t capacity() const noexcept - the most available() can ever return
+ *	void write(const char *data, size_t length) noexcept - only ever called with length <= available()
+ */
+
+// Adapts an existing (blocking) outDev, such as a polled UART, into a sink.
+struct outDevSink
+{
+private:
+	outDev &dev;
+
+public:
+	constexpr outDevSink(outDev &device) noexcept : dev(device) { }
+	constexpr size_t available() const noexcept { return SIZE_MAX; }
+	constexpr size_t capacity() const noexcept { return SIZE_MAX; }
+	void write(const char *const data, const size_t length) noexcept { dev.write(data, length); }
+};
+
+/*
+ * Single producer, single consumer RAM ring buffer sink, eg for an RTT-style host-polled buffer
+ * or as the TX buffer an interrupt-driven UART drains with read().
+ */
+template<size_t N> struct ringBufferSink
+{
+private:
+	static_assert(N && !(N & (N - 1)), "ringBufferSink: N must be a power of two");
+	array<char, N> buffer;
+	// Free-running indices, only ever masked when accessing the buffer.
+	atomic<size_t, nullBackend> head;
+	atomic<size_t, nullBackend> tail;
+
+public:
+	ringBufferSink() noexcept : buffer(), head(0), tail(0) { }
+
+	size_t pending() const noexcept { return head.load(memoryOrder::acquire) - tail.load(memoryOrder::relaxed); }
+	size_t available() const noexcept { return N - (head.load(memoryOrder::relaxed) - tail.load(memoryOrder::acquire)); }
+	constexpr size_t capacity() const noexcept { return N; }
+
+	void write(const char *const data, const size_t length) noexcept
+	{
+		const size_t start = head.load(memoryOrder::relaxed);
+		for (size_t i = 0; i < length; ++i)
+			buffer.data()[(start + i) & (N - 1)] = data[i];
+		head.store(start + length, memoryOrder::release);
+	}
+
+	size_t read(char *const data, const size_t length) noexcept
+	{
+		const size_t start = tail.load(memoryOrder::relaxed);
+		const size_t count = head.load(memoryOrder::acquire) - start;
+		const size_t amount = count < length ? count : length;
+		for (size_t i = 0; i < amount; ++i)
+			data[i] = buffer.data()[(start + i) & (N - 1)];
+		tail.store(start + amount, memoryOrder::release);
+		return amount;
+	}
+
+	ringBufferSink(const ringBufferSink &) = delete;
+	ringBufferSink(ringBufferSink &&) = delete;
+	ringBufferSink &operator =(const ringBufferSink &) = delete;
+	ringBufferSink &operator =(ringBufferSink &&) = delete;
+};
+
+template<typename... Sinks> struct __teeSinks;
+template<> struct __teeSinks<>
+{
+	constexpr __teeSinks() noexcept { }
+	void deliver(const char *const, const size_t, const severity) noexcept { }
+};
+
+template<typename Sink, typename... Rest> struct __teeSinks<Sink, Rest...>
+{
+	Sink &sink;
+	severity minimum;
+	overflowPolicy policy;
+	size_t dropped;
+	// Set once part of the current line has been dropped, until that line ends.
+	bool discarding;
+	__teeSinks<Rest...> rest;
+
+	constexpr __teeSinks(Sink &first, Rest &...others) noexcept : sink(first), minimum(severity::trace),
+		policy(overflowPolicy::drop), dropped(0), discarding(false), rest(others...) { }
+
+	void deliver(const char *const data, const size_t length, const severity level) noexcept
+	{
+		if (level >= minimum)
+		{
+			if (policy == overflowPolicy::drop)
+			{
+				const size_t space = sink.available();
+				if (discarding)
+					dropped += length;
+				else if (space >= length)
+					sink.write(data, length);
+				else
+				{
+					const size_t amount = length > sink.capacity() ? space : 0;
+					if (amount)
+						sink.write(data, amount);
+					dropped += length - amount;
+					discarding = true;
+				}
+				if (data[length - 1] == '\n')
+					discarding = false;
+			}
+			else
+			{
+				const char *block = data;
+				for (size_t remaining = length; remaining; )
+				{
+					const size_t space = sink.available();
+					const size_t amount = space < remaining ? space : remaining;
+					if (amount)
+						sink.write(block, amount);
+					block += amount;
+					remaining -= amount;
+				}
+			}
+		}
+		rest.deliver(data, length, level);
+	}
+};
+
+template<size_t I, typename... Sinks> struct __teeIndex;
+template<typename Sink, typename... Rest> struct __teeIndex<0, Sink, Rest...>
+{
+	typedef __teeSinks<Sink, Rest...> type;
+	static type &get(__teeSinks<Sink, Rest...> &sinks) noexcept { return sinks; }
+};
+template<size_t I, typename Sink, typename... Rest> struct __teeIndex<I, Sink, Rest...>
+{
+	typedef typename __teeIndex<I - 1, Rest...>::type type;
+	static type &get(__teeSinks<Sink, Rest...> &sinks) noexcept { return __teeIndex<I - 1, Rest...>::get(sinks.rest); }
+};
+
+/*
+ * outDev which formats once into a staging buffer and then hands the result to every sink as a single block,
+ * on each newline, on flush(), or when the staging buffer fills.
+ * Sinks are fed in the order given, so list the fast or most important ones first.
+ */
+template<typename... Sinks> struct teeOutDev : public outDev
+{
+private:
+	static_assert(sizeof...(Sinks) > 0, "teeOutDev: at least one sink is required");
+	char *const staging;
+	const size_t capacity;
+	size_t used;
+	severity level;
+	__teeSinks<Sinks...> sinks;
+	// Stands in for a zero length staging buffer, which leaves every character as a block of its own.
+	char unbuffered;
+
+	void initFn(const uint32_t) noexcept { used = 0; }
+
+	void writeFn(const char c) noexcept
+	{
+		staging[used++] = c;
+		if (c == '\n' || used == capacity)
+			flush();
+	}
+
+	static constexpr functions fns{init_t::make<teeOutDev, &teeOutDev::initFn>(),
+		write_t::make<teeOutDev, &teeOutDev::writeFn>()};
+
+	template<size_t I> typename __teeIndex<I, Sinks...>::type &sink() noexcept
+		{ return __teeIndex<I, Sinks...>::get(sinks); }
+
+public:
+	teeOutDev(char *const storage, const size_t length, Sinks &...outputs) noexcept : outDev(&fns, this),
+		staging(length ? storage : &unbuffered), capacity(length ? length : 1), used(0), level(severity::info),
+		sinks(outputs...), unbuffered(0) { }
+	template<size_t N> teeOutDev(array<char, N> &storage, Sinks &...outputs) noexcept :
+		teeOutDev(storage.data(), N, outputs...) { static_assert(N > 0, "teeOutDev: the staging buffer must not be empty"); }
+
+	void flush() noexcept
+	{
+		if (used)
+			sinks.deliver(staging, used, level);
+		used = 0;
+	}
+
+	// Sets the severity of the output that follows, flushing anything already staged at the old severity.
+	void setSeverity(const severity value) noexcept
+	{
+		flush();
+		level = value;
+	}
+
+	template<size_t I> void minSeverity(const severity value) noexcept { sink<I>().minimum = value; }
+	template<size_t I> void policy(const overflowPolicy value) noexcept { sink<I>().policy = value; }
+	// The number of bytes sink I has had dropped because it was full.
+	template<size_t I> size_t dropped() noexcept { return sink<I>().dropped; }
+
+	teeOutDev() = delete;
+	teeOutDev(const teeOutDev &) = delete;
+	teeOutDev(teeOutDev &&) = delete;
+	teeOutDev &operator =(const teeOutDev &) = delete;
+	teeOutDev &operator =(teeOutDev &&) = delete;
+};
+template<typename... Sinks> constexpr outDev::functions teeOutDev<Sinks...>::fns;
+
+#endif /*__TEE_OUT_DEV_H__*/
@@ -0,0 +1,103 @@
+// <cmath> comes first on purpose - the library's helpers must not collide with the C library's.
+#include <cmath>
+#include <algorithm.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "testing.h"
+
+struct five_t { int values[5]; };
+constexpr five_t sortedFive() noexcept
+{
+	five_t result{{5, 1, 4, 2, 3}};
+	sort(result.values, result.values + 5);
+	return result;
+}
+static_assert(sortedFive().values[0] == 1 && sortedFive().values[4] == 5, "sort must be usable in constant expressions");
+
+constexpr int table[] = {1, 3, 3, 5, 9};
+static_assert(lowerBound(table, table + 5, 3) == table + 1 && upperBound(table, table + 5, 3) == table + 3,
+	"searches must be usable in constant expressions");
+
+// The sorting networks, median and searches on fixed-size arrays.
+template<size_t N> bool checkFixed() noexcept
+{
+	bool ok = true;
+	for (size_t round = 0; round < 2000; ++round)
+	{
+		array<int, N> values;
+		array<int, N> medianOf;
+		std::vector<int> reference;
+		for (size_t i = 0; i < N; ++i)
+		{
+			values.data()[i] = medianOf.data()[i] = rand() % 10;
+			reference.push_back(values.data()[i]);
+		}
+		sort(values);
+		std::sort(reference.begin(), reference.end());
+		ok &= std::equal(reference.begin(), reference.end(), values.data());
+		ok &= median(medianOf) == reference[N / 2];
+		for (int key = -1; key < 11; ++key)
+		{
+			ok &= lowerBound(values, key) - values.data() ==
+				std::lower_bound(reference.begin(), reference.end(), key) - reference.begin();
+			ok &= upperBound(values, key) - values.data() ==
+				std::upper_bound(reference.begin(), reference.end(), key) - reference.begin();
+		}
+	}
+	return ok;
+}
+
+// Introsort, nthElement and the searches over runtime lengths, including sorted, reversed and duplicate-heavy input.
+bool checkDynamic() noexcept
+{
+	bool ok = true;
+	for (size_t length = 0; length < 600; ++length)
+	{
+		for (size_t round = 0; round < 20; ++round)
+		{
+			const int range = round % 3 ? 1000000 : 3;
+			std::vector<int> values(length);
+			for (auto &value : values)
+				value = rand() % range;
+			if (round == 1)
+				std::sort(values.begin(), values.end());
+			else if (round == 2)
+				std::sort(values.rbegin(), values.rend());
+
+			std::vector<int> reference = values;
+			std::vector<int> partitioned = values;
+			sort(iterate<int>(values.data(), length));
+			std::sort(reference.begin(), reference.end());
+			ok &= values == reference;
+
+			if (length)
+			{
+				const size_t nth = size_t(rand()) % length;
+				nthElement(partitioned.data(), partitioned.data() + nth, partitioned.data() + length);
+				ok &= partitioned[nth] == reference[nth];
+				for (size_t i = 0; i < nth; ++i)
+					ok &= !(partitioned[nth] < partitioned[i]);
+				for (size_t i = nth; i < length; ++i)
+					ok &= !(partitioned[i] < partitioned[nth]);
+			}
+
+			const int key = rand() % range;
+			ok &= lowerBound(iterate<int>(values.data(), length), key) - values.data() ==
+				std::lower_bound(values.begin(), values.end(), key) - values.begin();
+			ok &= upperBound(iterate<int>(values.data(), length), key) - values.data() ==
+				std::upper_bound(values.begin(), values.end(), key) - values.begin();
+		}
+	}
+	return ok;
+}
+
+int main()
+{
+	testCheck(checkFixed<1>() && checkFixed<2>() && checkFixed<3>() && checkFixed<4>() && checkFixed<5>() &&
+		checkFixed<6>() && checkFixed<7>() && checkFixed<8>(), "sorting networks");
+	testCheck(checkFixed<9>() && checkFixed<20>() && checkFixed<33>() && checkFixed<100>(), "sort on arrays");
+	testCheck(checkDynamic(), "sort, nthElement and searches");
+	testCheck(floorLog2(1) == 0 && floorLog2(1023) == 9 && floorLog2(1024) == 10, "floorLog2");
+	return testResult("algorithm");
+}
@@ -0,0 +1,14 @@
+#include <atomic.h>
+
+// Only ever compiled (make check-arm), to assemble the M-profile critical section backends.
+
+atomic<uint64_t> wide;
+atomic<uint32_t> word;
+
+uint64_t primaskSection() noexcept { return ++wide; }
+uint32_t wordOps() noexcept { return word.fetchAdd(1); }
+
+#if __ARM_ARCH_ISA_THUMB == 2
+atomic<uint64_t, basepriBackend<0x40>> masked;
+uint64_t basepriSection() noexcept { return ++masked; }
+#endif
@@ -0,0 +1,65 @@
+#include <atomic.h>
+#include <thread>
+#include "testing.h"
+
+// Hammers atomic<> and criticalSection<> from several threads - any lost update shows up in the final counts.
+
+struct wide_t { uint32_t a, b, c, d, e; };
+
+constexpr uint32_t threads = 4;
+constexpr uint32_t iterations = 200000;
+
+atomic<uint32_t> counter;
+atomic<uint8_t> narrow;
+atomic<wide_t> wide;
+uint64_t unprotected;
+
+void worker() noexcept
+{
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		counter.fetchAdd(1, memoryOrder::relaxed);
+		++narrow;
+
+		wide_t expected = wide.load();
+		wide_t next;
+		do
+		{
+			next = expected;
+			++next.a;
+			next.e = next.a * 3;
+		}
+		while (!wide.compareExchangeWeak(expected, next));
+
+		criticalSection<> section;
+		{
+			criticalSection<> nested;
+			++unprotected;
+		}
+	}
+}
+
+int main()
+{
+	static_assert(atomic<uint32_t>::isLockFree() && !atomic<wide_t>::isLockFree(),
+		"atomic: expected both the lock-free and critical section paths to be exercised");
+
+	std::thread pool[threads];
+	for (auto &thread : pool)
+		thread = std::thread(worker);
+	for (auto &thread : pool)
+		thread.join();
+
+	const uint32_t total = threads * iterations;
+	const wide_t result = wide;
+	testCheck(counter == total, "fetchAdd lost updates");
+	testCheck(narrow == uint8_t(total), "operator ++ lost updates");
+	testCheck(result.a == total && result.e == result.a * 3, "compareExchangeWeak lost or tore updates");
+	testCheck(unprotected == total, "nested criticalSection did not exclude other threads");
+
+	uint32_t expected = 5;
+	testCheck(!counter.compareExchangeStrong(expected, 1) && expected == total, "failed compareExchangeStrong");
+	testCheck(counter.exchange(7) == total && (counter |= 8) == 15 && counter-- == 15 && counter == 14,
+		"exchange and read-modify-write operators");
+	return testResult("atomic");
+}
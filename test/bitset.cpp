@@ -0,0 +1,83 @@
+#include <bitset.h>
+#include <bitset>
+#include <cstdlib>
+#include "testing.h"
+
+constexpr bitset<256> constant(3);
+static_assert(constant.test(0) && constant.test(1) && !constant.test(2) && constant.size() == 256,
+	"bitset must be constructible in constant expressions");
+static_assert(bitset<7>(0xFF).test(6) && !bitset<7>(0xFF).test(7), "bitset must mask off bits past N");
+
+// Applies the same random operations to a bitset and a std::bitset, comparing every query along the way.
+template<size_t N> bool checkAgainstStd() noexcept
+{
+	bitset<N> set;
+	std::bitset<N> reference;
+	bool ok = true;
+	for (size_t round = 0; round < 2000; ++round)
+	{
+		const size_t pos = size_t(rand()) % N;
+		switch (rand() % 4)
+		{
+			case 0:
+				set.set(pos);
+				reference.set(pos);
+				break;
+			case 1:
+				set.reset(pos);
+				reference.reset(pos);
+				break;
+			case 2:
+				set.flip(pos);
+				reference.flip(pos);
+				break;
+			default:
+				if (!(round % 97))
+				{
+					set.flip();
+					reference.flip();
+				}
+		}
+
+		size_t firstSet = N;
+		size_t firstClear = N;
+		size_t nextSet = N;
+		size_t nextClear = N;
+		for (size_t i = N; i-- > 0; )
+		{
+			ok &= set.test(i) == reference[i];
+			if (reference[i])
+				firstSet = i;
+			else
+				firstClear = i;
+			if (i > pos)
+			{
+				if (reference[i])
+					nextSet = i;
+				else
+					nextClear = i;
+			}
+		}
+		ok &= set.count() == reference.count() && set.any() == reference.any() &&
+			set.none() == reference.none() && set.all() == reference.all();
+		ok &= set.findFirstSet() == firstSet && set.findFirstClear() == firstClear;
+		ok &= set.findNextSet(pos) == nextSet && set.findNextClear(pos) == nextClear;
+	}
+
+	const bitset<N> mask(0x5A);
+	const std::bitset<N> referenceMask(0x5A);
+	ok &= (set & mask).count() == (reference & referenceMask).count();
+	ok &= (set | mask).count() == (reference | referenceMask).count();
+	ok &= (set ^ mask).count() == (reference ^ referenceMask).count();
+	ok &= (~set).count() == N - set.count() && ~~set == set && (set ^ set).none();
+	return ok;
+}
+
+int main()
+{
+	testCheck(checkAgainstStd<1>() && checkAgainstStd<7>() && checkAgainstStd<32>(), "bitset, single word");
+	testCheck(checkAgainstStd<63>() && checkAgainstStd<64>(), "bitset, whole word");
+	testCheck(checkAgainstStd<65>() && checkAgainstStd<128>() && checkAgainstStd<200>() &&
+		checkAgainstStd<256>() && checkAgainstStd<300>(), "bitset, multiple words");
+	return testResult("bitset");
+}
@@ -0,0 +1,66 @@
+#include <crc.h>
+#include "testing.h"
+
+// Check values are the CRC of "123456789", from the catalogue of parametrised CRC algorithms.
+
+static const char *const checkString = "123456789";
+
+template<crcMethod method> using crc5Usb_t = crc<5, 0x05, true, 0x1F, 0x1F, method>;
+template<crcMethod method> using crc7Mmc_t = crc<7, 0x09, false, 0x00, 0x00, method>;
+template<crcMethod method> using crc12Dect_t = crc<12, 0x80F, false, 0x000, 0x000, method>;
+template<crcMethod method> using crc16Riello_t = crc<16, 0x1021, true, 0xB2AA, 0x0000, method>;
+template<crcMethod method> using crc24OpenPgp_t = crc<24, 0x864CFB, false, 0xB704CE, 0x000000, method>;
+template<crcMethod method> using crc64Ecma_t = crc<64, 0x42F0E1EBA9EA3693, false, 0, 0, method>;
+template<crcMethod method> using crc64Xz_t = crc<64, 0x42F0E1EBA9EA3693, true, ~0ULL, ~0ULL, method>;
+
+// Every method must agree with the check value, and with each other when data arrives in arbitrary pieces.
+template<template<crcMethod> class crc_t, typename value_t> void checkCrc(const char *const name, const value_t expected) noexcept
+{
+	bool ok = crc_t<crcMethod::bitwise>::compute(checkString, 9) == expected &&
+		crc_t<crcMethod::nibbleTable>::compute(checkString, 9) == expected &&
+		crc_t<crcMethod::byteTable>::compute(checkString, 9) == expected &&
+		crc_t<crcMethod::sliceBy8>::compute(checkString, 9) == expected;
+
+	uint8_t data[1000];
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = uint8_t(i * 37 + 11);
+	const auto whole = crc_t<crcMethod::bitwise>::compute(data, sizeof(data));
+	crc_t<crcMethod::nibbleTable> bytewise;
+	for (const uint8_t byte : data)
+		bytewise.update(byte);
+	crc_t<crcMethod::byteTable> halves;
+	halves.update(data, 333).update(data + 333, 667);
+	crc_t<crcMethod::sliceBy8> unaligned;
+	unaligned.update(data, 5).update(data + 5, 17).update(data + 22, 978);
+	ok &= bytewise.value() == whole && halves.value() == whole && unaligned.value() == whole;
+	ok &= crc_t<crcMethod::sliceBy8>::compute(data, 7) == crc_t<crcMethod::bitwise>::compute(data, 7);
+
+	crc_t<crcMethod::byteTable> reused;
+	reused.update(data, 100);
+	reused.reset();
+	ok &= reused.update(checkString, 9).value() == expected;
+	testCheck(ok, name);
+}
+
+int main()
+{
+	checkCrc<crc5Usb_t>("CRC-5/USB", uint8_t(0x19));
+	checkCrc<crc7Mmc_t>("CRC-7/MMC", uint8_t(0x75));
+	checkCrc<crc8_t>("CRC-8/SMBUS", uint8_t(0xF4));
+	checkCrc<crc12Dect_t>("CRC-12/DECT", uint16_t(0xF5B));
+	checkCrc<crc16Ccitt_t>("CRC-16/IBM-3740", uint16_t(0x29B1));
+	checkCrc<crc16Modbus_t>("CRC-16/MODBUS", uint16_t(0x4B37));
+	checkCrc<crc16Riello_t>("CRC-16/RIELLO", uint16_t(0x63D0));
+	checkCrc<crc24OpenPgp_t>("CRC-24/OPENPGP", uint32_t(0x21CF02));
+	checkCrc<crc32_t>("CRC-32/ISO-HDLC", uint32_t(0xCBF43926));
+	checkCrc<crc32c_t>("CRC-32/ISCSI", uint32_t(0xE3069283));
+	checkCrc<crc64Ecma_t>("CRC-64/ECMA-182", uint64_t(0x6C40DF5F0B497347ULL));
+	checkCrc<crc64Xz_t>("CRC-64/XZ", uint64_t(0x995DC9BBDF1939FAULL));
+
+	uint8_t data[9];
+	memcpy(data, checkString, sizeof(data));
+	testCheck(crc32_t<>::compute(iterate<uint8_t>(data, sizeof(data))) == 0xCBF43926U, "CRC-32 over iterate<>");
+	array<uint8_t, 9> dataArray(data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7], data[8]);
+	testCheck(crc32_t<>::compute(dataArray) == 0xCBF43926U, "CRC-32 over array<>");
+	return testResult("crc");
+}
@@ -0,0 +1,200 @@
+#include <stdout.h>
+#include "testing.h"
+
+// Collects everything written to it so the formatters can be checked against expected strings.
+struct stringOutDev : public outDev
+{
+private:
+	void initFn(const uint32_t) noexcept { }
+	void writeFn(const char c) noexcept
+	{
+		if (used < sizeof(buffer) - 1)
+			buffer[used++] = c;
+		buffer[used] = 0;
+	}
+
+	static const functions fns;
+
+public:
+	char buffer[128];
+	size_t used;
+
+	stringOutDev() noexcept : outDev(&fns, this), buffer{}, used(0) { }
+	void clear() noexcept { buffer[used = 0] = 0; }
+};
+
+const outDev::functions stringOutDev::fns{init_t::make<stringOutDev, &stringOutDev::initFn>(),
+	write_t::make<stringOutDev, &stringOutDev::writeFn>()};
+
+stringOutDev device;
+stdout_t output(device);
+
+template<typename T> void check(const T &value, const char *const expected) noexcept
+{
+	device.clear();
+	output.write(value);
+	if (strcmp(device.buffer, expected))
+	{
+		testPrint("got '");
+		testPrint(device.buffer);
+		testPrint("', ");
+		testCheck(false, expected);
+	}
+}
+
+void testFloat() noexcept
+{
+	check(asFloat<>(1.5f), "1.5");
+	check(asFloat<>(0.1f), "0.1");
+	check(asFloat<>(-3.14159f), "-3.14159");
+	check(asFloat<>(100.0f), "100");
+	check(asFloat<>(0.001234f), "0.001234");
+	check(asFloat<>(1.5e-7f), "1.5e-7");
+	check(2.5f, "2.5");
+
+	check(asFloat<>(0.0f), "0");
+	check(asFloat<>(-0.0f), "-0");
+	check(asFloat<>(__builtin_inff()), "inf");
+	check(asFloat<>(-__builtin_inff()), "-inf");
+	check(asFloat<>(__builtin_nanf("")), "nan");
+	check(asFloat<>(3.4028235e38f), "3.4028235e38");
+
+	// Subnormals
+	check(asFloat<>(1e-45f), "1e-45");
+	check(asFloat<>(-1e-45f), "-1e-45");
+	check(asFloat<>(5.877472e-39f), "5.877472e-39");
+	check(asFloat<>(1.1754942e-38f), "1.1754942e-38");
+
+	// Plain notation runs out at 9 integer digits, after which the exponent is used.
+	check(asFloat<>(999999936.0f), "999999940");
+	check(asFloat<>(123456789.0f), "123456790");
+	check(asFloat<>(1e9f), "1e9");
+	check(asFloat<>(1e10f), "1e10");
+	check(asFloat<>(0.0001f), "0.0001");
+	check(asFloat<>(0.00001f), "0.00001");
+	check(asFloat<>(0.000001f), "1e-6");
+
+	// Rounding to precision, including carries that add a digit.
+	check(asFloat<3>(3.14159f), "3.14");
+	check(asFloat<3>(-12345.0f), "-12300");
+	check(asFloat<2>(9.99f), "10");
+	check(asFloat<1>(0.96f), "1");
+	check(asFloat<1>(-0.96f), "-1");
+	check(asFloat<2>(999999940.0f), "1e9");
+
+	// Rounding follows the exact value of the float, not its shortest digits, with exact halves going to even.
+	check(asFloat<2>(0.145f), "0.14");
+	check(asFloat<2>(0.155f), "0.16");
+	check(asFloat<1>(0.35f), "0.3");
+	check(asFloat<3>(2.675f), "2.67");
+	check(asFloat<4>(1.0005f), "1");
+	check(asFloat<1>(0.25f), "0.2");
+	check(asFloat<1>(0.75f), "0.8");
+	check(asFloat<1>(2.5f), "2");
+	check(asFloat<1>(-3.5f), "-4");
+	check(asFloat<2>(1.5e-44f), "1.5e-44");
+	check(asFloat<1>(1.5e-44f), "2e-44");
+}
+
+void testFixed() noexcept
+{
+	check(asFixed<16>(int32_t(0x18000)), "1.5");
+	check(asFixed<16>(int32_t(-0x18000)), "-1.5");
+	check(asFixed<8>(uint16_t(0x0101)), "1.00390625");
+	check(asFixed<4, 1>(int8_t(-0x18)), "-1.5");
+	check(asFixed<0>(int32_t(42)), "42");
+	check(asFixed<31>(int32_t(0x40000000)), "0.5");
+	check(asFixed<16, 3>(int32_t(0x7FFFFFFF)), "32768.000");
+
+	// Rounding to precision, including carries into the integer part.
+	check(asFixed<8, 2>(uint16_t(0x0101)), "1.00");
+	check(asFixed<8, 2>(uint16_t(0x01FF)), "2.00");
+	check(asFixed<8, 2>(int16_t(-0x01FF)), "-2.00");
+
+	// -0 and values that only round to it keep their sign.
+	check(asFixed<8>(int16_t(0)), "0");
+	check(asFixed<8, 1>(int16_t(-1)), "-0.0");
+
+	// The full 32 fractional bits, both signed and unsigned.
+	check(asFixed<32>(uint32_t(0xC0000000)), "0.75");
+	check(asFixed<32>(uint32_t(1)), "0.00000000023283064365386962890625");
+	check(asFixed<32>(uint32_t(0xFFFFFFFF)), "0.99999999976716935634613037109375");
+	check(asFixed<32, 2>(uint32_t(0xFFFFFFFF)), "1.00");
+	check(asFixed<32>(int32_t(0xC0000000)), "-0.25");
+}
+
+void testInt() noexcept
+{
+	check(int8_t(-128), "-128");
+	check(uint8_t(255), "255");
+	check(int16_t(-32768), "-32768");
+	check(uint16_t(65535), "65535");
+	check(int32_t(-2147483647 - 1), "-2147483648");
+	check(uint32_t(4294967295U), "4294967295");
+	check(int64_t(-9223372036854775807LL - 1), "-9223372036854775808");
+	check(uint64_t(18446744073709551615ULL), "18446744073709551615");
+	check(int32_t(0), "0");
+}
+
+void testHex() noexcept
+{
+	check(asHex<>(uint8_t(0)), "0");
+	check(asHex<>(uint32_t(0xABCDEF)), "ABCDEF");
+	check(asHex<2, '0'>(uint8_t(0x0A)), "0A");
+	check(asHex<8, '0'>(uint32_t(0x1234)), "00001234");
+	check(asHex<4>(uint8_t(0x0A)), "   A");
+	check(asHex<10, '.'>(uint32_t(0x12345678)), "..12345678");
+	check(asHex<1>(uint8_t(0xFF)), "FF");
+
+	// Signed values narrower than 32 bits only print their own digits.
+	check(asHex<2, '0'>(int8_t(-1)), "FF");
+	check(asHex<>(int8_t(-128)), "80");
+	check(asHex<>(int16_t(-2)), "FFFE");
+	check(asHex<4, '0'>(int16_t(-32768)), "8000");
+	check(asHex<>(int32_t(-1)), "FFFFFFFF");
+
+	// 64-bit values keep their high half, with the low half zero filled under it.
+	check(asHex<>(uint64_t(0x1122334455667788)), "1122334455667788");
+	check(asHex<>(uint64_t(0x100000000)), "100000000");
+	check(asHex<>(uint64_t(0xABCD)), "ABCD");
+	check(asHex<12, '.'>(uint64_t(0x1200000034)), "..1200000034");
+	check(asHex<16, '0'>(uint64_t(0x1234)), "0000000000001234");
+	check(asHex<>(int64_t(-1)), "FFFFFFFFFFFFFFFF");
+
+	array<uint8_t, 4> bytes(1, 0xAB, 0, 0xFF);
+	check(bytes, "01AB00FF");
+	array<int8_t, 3> signedBytes(int8_t(-1), int8_t(0x12), int8_t(-128));
+	check(signedBytes, "FF1280");
+	array<int16_t, 2> signedWords(int16_t(-2), int16_t(0x34));
+	check(signedWords, "FFFE0034");
+	// Pointers print every digit of their own width.
+	check(reinterpret_cast<int *>(0x1234), sizeof(void *) == 8 ? "0x0000000000001234" : "0x00001234");
+	array<uint64_t, 2> quads(uint64_t(0x0102030405060708), uint64_t(0xA));
+	check(quads, "0102030405060708000000000000000A");
+}
+
+void testBuffer() noexcept
+{
+	array<char, 8> storage;
+	bufferOutDev buffer(storage);
+	stdout_t bufferOutput(buffer);
+	bufferOutput.write("T="_sv, asInt<uint8_t>(42));
+	testCheck(buffer.length() == 4 && !memcmp(buffer.data(), "T=42", 4), "bufferOutDev collects output");
+	testCheck(buffer.view().size() == 4 && !buffer.truncated(), "bufferOutDev view");
+	bufferOutput.write(" overflow");
+	testCheck(buffer.length() == 8 && buffer.required() == 13 && buffer.truncated(), "bufferOutDev truncation");
+	buffer.reset();
+	testCheck(!buffer.length() && !buffer.truncated(), "bufferOutDev reset");
+	check("abc"_sv, "abc");
+	check(stringView("abcdef", 2), "ab");
+}
+
+int main()
+{
+	testFloat();
+	testFixed();
+	testInt();
+	testHex();
+	testBuffer();
+	return testResult("formatting");
+}
@@ -0,0 +1,157 @@
+#include <intrusiveList.h>
+#include <intrusiveHeap.h>
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <set>
+#include <utility>
+#include "testing.h"
+
+// Drives intrusiveList and intrusiveHeap with random operations, mirroring them onto std::list and std::multiset.
+
+struct heapTag_t;
+struct testTimer : public listNode<>, public heapNode<heapTag_t>
+{
+	uint32_t deadline;
+	uint32_t id;
+	bool operator <(const testTimer &other) const noexcept { return deadline < other.deadline; }
+};
+
+typedef intrusiveHeap<testTimer, lessThan<testTimer>, heapTag_t> testTimerHeap;
+constexpr size_t timerCount = 4096;
+// Static so their node constructors must be constant-initialised for the heap to start out consistent.
+testTimer timers[timerCount];
+
+bool checkList() noexcept
+{
+	intrusiveList<testTimer> list;
+	std::list<uint32_t> reference;
+	bool ok = true;
+	for (size_t round = 0; round < 100000; ++round)
+	{
+		testTimer &timer = timers[size_t(rand()) % timerCount];
+		if (timer.listNode<>::isLinked())
+		{
+			list.remove(timer);
+			reference.remove(timer.id);
+		}
+		else if (rand() & 1)
+		{
+			list.pushBack(timer);
+			reference.push_back(timer.id);
+		}
+		else
+		{
+			list.pushFront(timer);
+			reference.push_front(timer.id);
+		}
+		ok &= list.size() == reference.size() && list.empty() == reference.empty();
+	}
+	auto expected = reference.begin();
+	for (const auto &timer : list)
+		ok &= expected != reference.end() && timer.id == *expected++;
+	ok &= expected == reference.end();
+	if (!list.empty())
+		ok &= list.front().id == reference.front() && list.back().id == reference.back();
+
+	// Removing the current element while walking with iterators.
+	for (auto &timer : list)
+	{
+		if (timer.id & 1)
+			list.remove(timer);
+	}
+	reference.remove_if([](const uint32_t id) noexcept { return id & 1; });
+	ok &= list.size() == reference.size();
+	for (const auto &timer : list)
+		ok &= !(timer.id & 1);
+
+	// Moving elements onto another list mid-walk, which plain iterators cannot survive.
+	intrusiveList<testTimer> expired;
+	list.forEach([&](testTimer &timer) noexcept
+	{
+		if (timer.id % 3 == 0)
+		{
+			list.remove(timer);
+			expired.pushBack(timer);
+		}
+	});
+	const size_t moved = size_t(std::count_if(reference.begin(), reference.end(),
+		[](const uint32_t id) noexcept { return id % 3 == 0; }));
+	ok &= expired.size() == moved && list.size() == reference.size() - moved;
+	for (const auto &timer : expired)
+		ok &= timer.id % 3 == 0;
+
+	ok &= expired.removeIf([](const testTimer &timer) noexcept { return timer.id % 4 == 0; }) ==
+		size_t(std::count_if(reference.begin(), reference.end(), [](const uint32_t id) noexcept { return id % 12 == 0; }));
+	for (const auto &timer : expired)
+		ok &= timer.id % 4 != 0;
+
+	for (auto it = list.begin(); it != list.end(); )
+		it = list.erase(it);
+	expired.clear();
+	ok &= list.empty() && expired.empty();
+	for (const auto &timer : timers)
+		ok &= !timer.listNode<>::isLinked();
+	return ok;
+}
+
+bool checkHeap() noexcept
+{
+	testTimerHeap heap;
+	std::multiset<std::pair<uint32_t, uint32_t>> reference;
+	bool ok = true;
+	for (const auto &timer : timers)
+		ok &= !timer.heapNode<heapTag_t>::isLinked();
+
+	for (size_t round = 0; round < 200000; ++round)
+	{
+		testTimer &timer = timers[size_t(rand()) % timerCount];
+		const int operation = rand() % 3;
+		if (!timer.heapNode<heapTag_t>::isLinked())
+		{
+			timer.deadline = uint32_t(rand()) % 100000;
+			heap.push(timer);
+			reference.emplace(timer.deadline, timer.id);
+		}
+		else if (operation == 0)
+		{
+			heap.remove(timer);
+			reference.erase(reference.find(std::make_pair(timer.deadline, timer.id)));
+		}
+		else if (operation == 1)
+		{
+			testTimer &first = heap.pop();
+			ok &= first.deadline == reference.begin()->first && !first.heapNode<heapTag_t>::isLinked();
+			reference.erase(reference.find(std::make_pair(first.deadline, first.id)));
+		}
+		else
+		{
+			reference.erase(reference.find(std::make_pair(timer.deadline, timer.id)));
+			timer.deadline = uint32_t(rand()) % 100000;
+			heap.update(timer);
+			reference.emplace(timer.deadline, timer.id);
+		}
+		ok &= heap.size() == reference.size();
+		if (!heap.empty())
+			ok &= heap.top().deadline == reference.begin()->first;
+	}
+
+	uint32_t last = 0;
+	while (!heap.empty())
+	{
+		const testTimer &timer = heap.pop();
+		ok &= timer.deadline >= last;
+		last = timer.deadline;
+	}
+	ok &= heap.size() == 0;
+	return ok;
+}
+
+int main()
+{
+	for (uint32_t i = 0; i < timerCount; ++i)
+		timers[i].id = i;
+	testCheck(checkList(), "intrusiveList against std::list");
+	testCheck(checkHeap(), "intrusiveHeap against std::multiset");
+	return testResult("intrusive");
+}
@@ -0,0 +1,69 @@
+#include <ryu.h>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include "testing.h"
+
+/*
+ * Checks floatToDecimal() against the standard library's shortest round-trip formatting.
+ * By default every 61st positive finite float is checked, with the subnormal range done exhaustively;
+ * pass --exhaustive (make check-exhaustive) to check all 2^31 - 2^23 of them.
+ */
+
+static bool matchesToChars(const uint32_t bits) noexcept
+{
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	char buffer[64];
+	const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+	*result.ptr = 0;
+
+	// Pull the reference digits and exponent back out of d.ddde[+-]x
+	const char *const exponent = strchr(buffer, 'e');
+	uint32_t mantissa = 0;
+	int32_t digits = 0;
+	for (const char *digit = buffer; digit != exponent; ++digit)
+	{
+		if (*digit >= '0' && *digit <= '9')
+		{
+			mantissa = (mantissa * 10) + uint32_t(*digit - '0');
+			++digits;
+		}
+	}
+
+	floatDecimal_t decimal = floatToDecimal(bits);
+	while (decimal.mantissa && !(decimal.mantissa % 10))
+	{
+		decimal.mantissa /= 10;
+		++decimal.exponent;
+	}
+	return decimal.mantissa == mantissa && decimal.exponent == atoi(exponent + 1) - (digits - 1);
+}
+
+int main(int argc, char **argv)
+{
+	const bool exhaustive = argc > 1 && !strcmp(argv[1], "--exhaustive");
+	const uint32_t step = exhaustive ? 1 : 61;
+	size_t mismatches = 0;
+
+	for (uint32_t bits = 1; bits < 0x00800000U; bits += exhaustive ? 1 : 7)
+		mismatches += !matchesToChars(bits);
+	for (uint64_t bits = 0x00800000U; bits < 0x7F800000U; bits += step)
+		mismatches += !matchesToChars(uint32_t(bits));
+	// Always hit the extremes the stride skips over.
+	mismatches += !matchesToChars(0x00000001U);
+	mismatches += !matchesToChars(0x007FFFFFU);
+	mismatches += !matchesToChars(0x7F7FFFFFU);
+
+	testCheck(!mismatches, "floatToDecimal() disagrees with std::to_chars()");
+
+	// 0.145f is 0.14499999582767486572265625, 0.25f is exact and 1e-45f is 2^-149.
+	testCheck(compareFloatToDecimal(0x3E147AE1U, {145, -3}) < 0 && compareFloatToDecimal(0x3E147AE1U, {144, -3}) > 0,
+		"compareFloatToDecimal() on an inexact value");
+	testCheck(!compareFloatToDecimal(0x3E800000U, {25, -2}), "compareFloatToDecimal() on an exact value");
+	testCheck(compareFloatToDecimal(0x00000001U, {1, -45}) > 0 && compareFloatToDecimal(0x00000001U, {15, -46}) < 0,
+		"compareFloatToDecimal() on a subnormal");
+	testCheck(compareFloatToDecimal(0x7F7FFFFFU, {34028235, 31}) < 0 && compareFloatToDecimal(0x7F7FFFFFU, {34028234, 31}) > 0,
+		"compareFloatToDecimal() on the largest float");
+	return testResult("ryu");
+}
@@ -0,0 +1,141 @@
+#include <teeOutDev.h>
+#include <chrono>
+#include <thread>
+#include "testing.h"
+
+// Feeds teeOutDev into in-memory and ring buffer sinks, checking what each one ends up with.
+
+// Holds up to room bytes until cleared, like a sink nobody drains.
+struct memorySink
+{
+	char data[256];
+	size_t length;
+	size_t room;
+
+	memorySink(const size_t limit = sizeof(data)) noexcept : data{}, length(0), room(limit) { }
+	size_t available() const noexcept { return room - length; }
+	size_t capacity() const noexcept { return room; }
+	void write(const char *const block, const size_t amount) noexcept
+	{
+		memcpy(data + length, block, amount);
+		length += amount;
+	}
+
+	void clear() noexcept { length = 0; }
+	bool holds(const char *const expected) const noexcept
+		{ return length == strlen(expected) && !memcmp(data, expected, length); }
+};
+
+void testSeverity() noexcept
+{
+	memorySink all;
+	memorySink warnings;
+	array<char, 32> staging;
+	teeOutDev<memorySink, memorySink> tee(staging, all, warnings);
+	stdout_t output(tee);
+	tee.minSeverity<1>(severity::warning);
+
+	output.write("info\n");
+	tee.setSeverity(severity::error);
+	output.write("error ", 42, '\n');
+	tee.setSeverity(severity::debug);
+	output.write("debug");
+	tee.flush();
+	testCheck(all.holds("info\nerror 42\ndebug"), "severity: a trace sink sees everything");
+	testCheck(warnings.holds("error 42\n"), "severity: a warning sink only sees warnings and above");
+	testCheck(!tee.dropped<0>() && !tee.dropped<1>(), "severity: filtered output does not count as dropped");
+}
+
+void testDrop() noexcept
+{
+	memorySink small(12);
+	memorySink large;
+	array<char, 8> staging;
+	teeOutDev<memorySink, memorySink> tee(staging, small, large);
+	stdout_t output(tee);
+
+	// Staged as "abcdefgh", "ijklmnop" and "\n" - once the second block is dropped the newline must go too.
+	output.write("abcdefghijklmnop\n");
+	testCheck(small.holds("abcdefgh"), "drop: only the blocks that fit are kept");
+	testCheck(tee.dropped<0>() == 9, "drop: the rest of a partly dropped line is counted as dropped");
+	testCheck(large.holds("abcdefghijklmnop\n") && !tee.dropped<1>(), "drop: one full sink does not affect the others");
+
+	small.clear();
+	output.write("xyz\n");
+	testCheck(small.holds("xyz\n"), "drop: the next line is delivered again once there is room");
+	testCheck(tee.dropped<0>() == 9, "drop: delivered lines are not counted");
+}
+
+void testOversized() noexcept
+{
+	ringBufferSink<16> ring;
+	array<char, 64> staging;
+	teeOutDev<ringBufferSink<16>> tee(staging, ring);
+	stdout_t output(tee);
+
+	// A block bigger than the ring can ever hold is cut down to what fits rather than dropped every time.
+	output.write("0123456789abcdefghijklmnopqrstuvwxyzABCD\n");
+	char data[16];
+	testCheck(ring.read(data, sizeof(data)) == 16 && !memcmp(data, "0123456789abcdef", 16),
+		"oversized: the start of the block is kept");
+	testCheck(tee.dropped<0>() == 25, "oversized: the remainder is counted as dropped");
+
+	output.write("ok\n");
+	testCheck(ring.read(data, sizeof(data)) == 3 && !memcmp(data, "ok\n", 3), "oversized: the next line is delivered");
+}
+
+void testUnbuffered() noexcept
+{
+	memorySink sink;
+	char unused;
+	teeOutDev<memorySink> tee(&unused, 0, sink);
+	stdout_t output(tee);
+
+	output.write("ab\n");
+	testCheck(sink.holds("ab\n"), "unbuffered: a zero length staging buffer passes each character straight through");
+}
+
+void testBlock() noexcept
+{
+	ringBufferSink<16> ring;
+	memorySink fast;
+	array<char, 64> staging;
+	teeOutDev<ringBufferSink<16>, memorySink> tee(staging, ring, fast);
+	stdout_t output(tee);
+	tee.policy<0>(overflowPolicy::block);
+
+	const char *const lines[] = {"short\n", "a line rather longer than the whole ring buffer\n", "x\n",
+		"and another one which also needs several trips round the ring\n"};
+	char expected[256] = {};
+	for (const char *const line : lines)
+		strcat(expected, line);
+	const size_t total = strlen(expected);
+
+	// Drains a few bytes at a time, slowly enough that the writer keeps finding the ring full.
+	char received[256] = {};
+	std::thread drainer([&]() noexcept
+	{
+		for (size_t length = 0; length < total; )
+		{
+			length += ring.read(received + length, 3);
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	});
+	for (const char *const line : lines)
+		output.write(line);
+	drainer.join();
+
+	testCheck(!memcmp(received, expected, total) && !ring.pending(), "block: a blocking sink receives everything in order");
+	testCheck(!tee.dropped<0>(), "block: nothing is dropped");
+	testCheck(fast.holds(expected), "block: later sinks still receive everything");
+}
+
+int main()
+{
+	testSeverity();
+	testDrop();
+	testOversized();
+	testUnbuffered();
+	testBlock();
+	return testResult("teeOutDev");
+}
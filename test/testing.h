@@ -0,0 +1,40 @@
+#ifndef __TESTING_H__
+#define __TESTING_H__
+
+/*
+ * Minimal harness for the host-side tests run by `make check`.
+ * The tests deliberately avoid <cstdio> and friends, as stdout.h declares its own global stdout.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+inline size_t &testFailures() noexcept
+{
+	static size_t failures = 0;
+	return failures;
+}
+
+inline void testPrint(const char *const str) noexcept
+	{ static_cast<void>(::write(STDERR_FILENO, str, strlen(str))); }
+
+inline void testCheck(const bool ok, const char *const what) noexcept
+{
+	if (ok)
+		return;
+	++testFailures();
+	testPrint("FAIL: ");
+	testPrint(what);
+	testPrint("\n");
+}
+
+// Call last from main() - reports the outcome for `name` and gives the exit code.
+inline int testResult(const char *const name) noexcept
+{
+	testPrint(name);
+	testPrint(testFailures() ? ": FAILED\n" : ": ok\n");
+	return testFailures() ? 1 : 0;
+}
+
+#endif /*__TESTING_H__*/